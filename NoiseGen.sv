@@ -0,0 +1,99 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company:
+// Engineer:
+//
+// Create Date: 10/19/2026 01:40:22 PM
+// Design Name:
+// Module Name: NoiseGen
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description: Seedable noise source for MODE_NOISE. A xorshift32 generator
+//              steps once per sample; the output is its upper 16 bits (white),
+//              a 7-row Voss-McCartney sum (pink) or a one-pole low-pass of
+//              the white noise (band-limited). NoiseModel in wavegen_model.h
+//              is the bit-exact C++ model, keep the two in step.
+//
+// Dependencies:
+//
+// Revision:
+// Revision 0.01 - File Created
+// Additional Comments:
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module NoiseGen(
+    input CLK,                  // sample clock
+    input RST,                  // reload the seed
+    input STEP,                 // advance one sample
+    input [31:0] SEED,          // 0 selects DEFAULT_SEED, writing a new seed reloads
+    input [1:0] SHAPE,          // 0 = white, 1 = pink, 2 = band-limited
+    output reg signed [15:0] NOISE = 0
+);
+    localparam WHITE = 2'd0, PINK = 2'd1, BAND = 2'd2;
+    localparam [31:0] DEFAULT_SEED = 32'h2545F491;
+
+    reg [31:0] state = DEFAULT_SEED;
+    reg [31:0] seed_q = 0;
+
+    // xorshift32 (13, 17, 5)
+    wire [31:0] x1 = state ^ (state << 13);
+    wire [31:0] x2 = x1 ^ (x1 >> 17);
+    wire [31:0] next = x2 ^ (x2 << 5);
+    wire signed [15:0] white = next[31:16];
+
+    // Pink: row k is refreshed every 2**(k+1) samples. The white term and the
+    // rows are scaled by 1/8 so the sum of all eight always fits in 16 bits.
+    reg [6:0] counter = 0;
+    reg signed [12:0] rows [0:6];
+    wire [6:0] count_next = counter + 1;
+    wire [6:0] row_update = count_next & ~(count_next - 1); // lowest set bit
+    wire signed [12:0] row_value = next[15:3];
+    wire signed [12:0] r0 = row_update[0] ? row_value : rows[0];
+    wire signed [12:0] r1 = row_update[1] ? row_value : rows[1];
+    wire signed [12:0] r2 = row_update[2] ? row_value : rows[2];
+    wire signed [12:0] r3 = row_update[3] ? row_value : rows[3];
+    wire signed [12:0] r4 = row_update[4] ? row_value : rows[4];
+    wire signed [12:0] r5 = row_update[5] ? row_value : rows[5];
+    wire signed [12:0] r6 = row_update[6] ? row_value : rows[6];
+    wire signed [12:0] white_8 = next[31:19];
+    wire signed [15:0] pink = white_8 + r0 + r1 + r2 + r3 + r4 + r5 + r6;
+
+    // Band-limited: y += (x - y)/4, corner near fs/25
+    reg signed [15:0] lp = 0;
+    wire signed [16:0] lp_diff = white - lp;
+    wire signed [15:0] band = lp + (lp_diff >>> 2);
+
+    integer i;
+    always @ (posedge CLK)
+        if (RST || SEED != seed_q)
+        begin
+            state <= (SEED == 0) ? DEFAULT_SEED : SEED;
+            seed_q <= SEED;
+            counter <= 0;
+            for (i = 0; i < 7; i = i + 1)
+                rows[i] <= 0;
+            lp <= 0;
+            NOISE <= 0;
+        end
+        else if (STEP)
+        begin
+            state <= next;
+            counter <= count_next;
+            rows[0] <= r0;
+            rows[1] <= r1;
+            rows[2] <= r2;
+            rows[3] <= r3;
+            rows[4] <= r4;
+            rows[5] <= r5;
+            rows[6] <= r6;
+            lp <= band;
+            case (SHAPE)
+                PINK:    NOISE <= pink;
+                BAND:    NOISE <= band;
+                default: NOISE <= white;
+            endcase
+        end
+endmodule
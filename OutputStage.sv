@@ -0,0 +1,81 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company:
+// Engineer:
+//
+// Create Date: 10/19/2026 05:03:19 PM
+// Design Name:
+// Module Name: OutputStage
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description: Output scaling for one channel, OUT = WAVE * AMPLITUDE / 2**15
+//              + OFFSET, as a 4-stage pipeline that maps onto one DSP48
+//              (input, multiply, post-add and output registers). The sum
+//              saturates to the 16-bit range instead of wrapping. Disabled
+//              channels output 0, gated or finished ones IDLE. Latency is 4
+//              clocks. OutputModel in wavegen_model.h is the C++ model.
+//
+// Dependencies:
+//
+// Revision:
+// Revision 0.01 - File Created
+// Additional Comments:
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module OutputStage(
+    input CLK,
+    input signed [15:0] WAVE,
+    input signed [15:0] AMPLITUDE,      // units of 100uV, full scale WAVE is 1V * AMPLITUDE
+    input signed [15:0] OFFSET,         // units of 100uV
+    input signed [15:0] IDLE,           // units of 100uV
+    input ENABLE,
+    input ACTIVE,                       // running, else IDLE
+    output reg signed [15:0] OUT = 0
+);
+    localparam signed [17:0] MAX = 2**15 - 1, MIN = -(2**15);
+
+    // Stage 1: DSP input registers
+    reg signed [15:0] wave_q = 0, amp_q = 0, offset_q = 0;
+    // Stage 2: multiply
+    (* use_dsp = "yes" *) reg signed [31:0] product = 0;
+    reg signed [15:0] offset_qq = 0;
+    // Stage 3: post-add
+    (* use_dsp = "yes" *) reg signed [17:0] sum = 0;
+
+    // Output select and idle level ride along with the data
+    reg [2:0] enable_d = 0, active_d = 0;
+    reg signed [15:0] idle_d [0:2];
+
+    always @ (posedge CLK)
+    begin
+        wave_q <= WAVE;
+        amp_q <= AMPLITUDE;
+        offset_q <= OFFSET;
+
+        product <= wave_q * amp_q;
+        offset_qq <= offset_q;
+
+        sum <= (product >>> 15) + offset_qq;
+
+        // Stage 4: saturate and select
+        if (~enable_d[2])
+            OUT <= 16'sd0;
+        else if (~active_d[2])
+            OUT <= idle_d[2];
+        else if (sum > MAX)
+            OUT <= MAX[15:0];
+        else if (sum < MIN)
+            OUT <= MIN[15:0];
+        else
+            OUT <= sum[15:0];
+
+        enable_d <= {enable_d[1:0], ENABLE};
+        active_d <= {active_d[1:0], ACTIVE};
+        idle_d[0] <= IDLE;
+        idle_d[1] <= idle_d[0];
+        idle_d[2] <= idle_d[1];
+    end
+endmodule
@@ -0,0 +1,81 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company:
+// Engineer:
+//
+// Create Date: 10/19/2026 05:12:48 PM
+// Design Name:
+// Module Name: PhaseScale
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description: Phase increment and phase offset for one channel, with the
+//              constant divides done as registered reciprocal multiplies:
+//                DELTA  = floor(FREQ * 2**32 / SAMPLING_FREQUENCY)
+//                OFFSET = trunc(PHASE_OFFS * 2**30 / 9000)
+//              Both are exact (the reciprocals are rounded up with enough
+//              fraction bits). The frequency product is split into 16-bit
+//              partial products with a register after every step, so no DSP
+//              cascade is longer than two blocks. A new FREQ appears 4
+//              clocks after it is written, a new PHASE_OFFS 3 clocks.
+//              PhaseScaleModel in wavegen_model.h is the C++ model.
+//
+// Dependencies:
+//
+// Revision:
+// Revision 0.01 - File Created
+// Additional Comments:
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module PhaseScale
+#(
+    parameter int SAMPLING_FREQUENCY = 50000
+)(
+    input CLK,
+    input [31:0] FREQ,                      // units of 100uHz
+    input signed [15:0] PHASE_OFFS,         // units of 0.01 degrees
+    output reg [31:0] DELTA = 0,
+    output reg signed [31:0] OFFSET = 0
+);
+    // 2**FREQ_SHIFT >= 2**32 * SAMPLING_FREQUENCY keeps the floor exact
+    localparam int FREQ_SHIFT = 32 + $clog2(SAMPLING_FREQUENCY);
+    localparam [95:0] FREQ_RECIP = ((96'd1 << (32 + FREQ_SHIFT)) + SAMPLING_FREQUENCY - 1) / SAMPLING_FREQUENCY;
+    // DELTA keeps 32 bits, so the integer part of the reciprocal only needs
+    // FREQ * RECIP_INT mod 2**32; the fraction is split over the two halves
+    // of FREQ
+    localparam [31:0] RECIP_INT = FREQ_RECIP >> FREQ_SHIFT;
+    localparam [FREQ_SHIFT-1:0] RECIP_FRAC = FREQ_RECIP[FREQ_SHIFT-1:0];
+    localparam int PHASE_SHIFT = 28;
+    localparam [63:0] PHASE_RECIP = ((64'd1 << (30 + PHASE_SHIFT)) + 9000 - 1) / 9000;
+
+    reg [31:0] freq_q = 0;
+    reg [15:0] phase_mag = 0;
+    reg phase_neg = 0, phase_neg_q = 0;
+    (* use_dsp = "yes" *) reg [31:0] int_product = 0;
+    (* use_dsp = "yes" *) reg [FREQ_SHIFT+15:0] frac_product_lo = 0, frac_product_hi = 0;
+    reg [31:0] int_q = 0;
+    reg [FREQ_SHIFT+31:0] frac_sum = 0;
+    (* use_dsp = "yes" *) reg [61:0] phase_product = 0;
+
+    // The offset is scaled as a magnitude so it truncates toward zero
+    wire [31:0] phase_scaled = phase_product >> PHASE_SHIFT;
+
+    always @ (posedge CLK)
+    begin
+        freq_q <= FREQ;
+        int_product <= freq_q * RECIP_INT;
+        frac_product_lo <= freq_q[15:0] * RECIP_FRAC;
+        frac_product_hi <= freq_q[31:16] * RECIP_FRAC;
+        int_q <= int_product;
+        frac_sum <= frac_product_lo + (frac_product_hi << 16);
+        DELTA <= int_q + frac_sum[FREQ_SHIFT +: 32];
+
+        phase_neg <= PHASE_OFFS < 0;
+        phase_mag <= (PHASE_OFFS < 0) ? -PHASE_OFFS : PHASE_OFFS;
+        phase_neg_q <= phase_neg;
+        phase_product <= phase_mag * PHASE_RECIP[45:0];
+        OFFSET <= phase_neg_q ? -$signed(phase_scaled) : $signed(phase_scaled);
+    end
+endmodule
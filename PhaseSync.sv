@@ -0,0 +1,97 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company:
+// Engineer:
+//
+// Create Date: 10/19/2026 09:12:40 AM
+// Design Name:
+// Module Name: PhaseSync
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description: Multi-board start synchronization. The master drives SYNC_OUT
+//              once armed and running, slaves forward SYNC_IN to SYNC_OUT
+//              (daisy chain).
+//              Every board, master included, waits for the same synchronized
+//              edge, then drops GATE for one sample to reset the phase
+//              accumulators and releases RUN.
+//
+// Dependencies:
+//
+// Revision:
+// Revision 0.01 - File Created
+// Additional Comments:
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module PhaseSync
+#(
+    parameter int PULSE_SAMPLES = 4 // width of the master sync pulse
+)(
+    input CLK,              // sample clock
+    input [1:0] MODE,       // 0 = off, 1 = master, 2 = slave
+    input ARM,              // toggles once per arm request (AXI clock domain)
+    input RUN,              // any channel enabled (AXI clock domain)
+    input SYNC_IN,
+    output SYNC_OUT,
+    output ARMED,           // waiting for the sync edge
+    output GATE             // ANDed with RUN
+);
+    localparam OFF = 2'd0, MASTER = 2'd1, SLAVE = 2'd2;
+
+    reg [2:0] arm_sync = 0;
+    reg [1:0] run_sync = 0;
+    reg fire = 0;           // master armed, sends its pulse once RUN is set
+    reg [7:0] pulse = 0;
+    reg waiting = 0;
+    reg reset = 0;
+
+    // The master listens to its own pulse so it sees the edge through the same
+    // synchronizer as the slaves do
+    wire sync_src = (MODE == MASTER) ? (pulse != 0) : SYNC_IN;
+    reg [2:0] sync_sync = 0;
+
+    wire arm_request = arm_sync[2] ^ arm_sync[1];
+    wire sync_edge = sync_sync[1] & ~sync_sync[2];
+
+    always @ (posedge CLK)
+    begin
+        arm_sync <= {arm_sync[1:0], ARM};
+        sync_sync <= {sync_sync[1:0], sync_src};
+        run_sync <= {run_sync[0], RUN};
+
+        if (MODE == OFF)
+        begin
+            fire <= 1'b0;
+            pulse <= 0;
+            waiting <= 1'b0;
+            reset <= 1'b0;
+        end
+        else
+        begin
+            // The master holds its edge until RUN is set, so its own outputs
+            // are enabled and gated when the edge arrives, like the slaves
+            if (arm_request && MODE == MASTER)
+                fire <= 1'b1;
+            else if (fire && run_sync[1])
+                fire <= 1'b0;
+
+            if (fire && run_sync[1] && !arm_request)
+                pulse <= PULSE_SAMPLES;
+            else if (pulse != 0)
+                pulse <= pulse - 1;
+
+            if (sync_edge)
+                waiting <= 1'b0;
+            else if (arm_request)
+                waiting <= 1'b1;
+
+            reset <= sync_edge;
+        end
+    end
+
+    assign SYNC_OUT = (MODE == MASTER) ? (pulse != 0) : (MODE == SLAVE) ? SYNC_IN : 1'b0;
+    assign ARMED = waiting;
+    assign GATE = ~waiting & ~reset;
+endmodule
@@ -0,0 +1,92 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company:
+// Engineer:
+//
+// Create Date: 10/19/2026 04:05:31 PM
+// Design Name:
+// Module Name: StreamFifo
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description: Sample FIFO for MODE_STREAM. An AXI-Stream slave (fed by an
+//              AXI DMA MM2S channel reading a DDR ring) pushes one word per
+//              sample, {B[31:16], A[15:0]}, and every sample clock pops one
+//              while ENABLE is set. TREADY drops when the FIFO is full, so the
+//              DMA is paced by the DAC rate. When the FIFO runs empty the last
+//              sample is held and UNDERRUNS counts the missing samples.
+//
+// Dependencies:
+//
+// Revision:
+// Revision 0.01 - File Created
+// Additional Comments:
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module StreamFifo
+#(
+    parameter int ADDR_WIDTH = 10       // depth is 2**ADDR_WIDTH samples
+)(
+    input CLK,                          // AXI clock
+    input RESETN,
+    input FLUSH,                        // one clock, empties the FIFO
+    input CLEAR,                        // one clock, clears UNDERRUNS
+
+    // AXI-Stream slave
+    input [31:0] S_AXIS_TDATA,
+    input S_AXIS_TVALID,
+    output S_AXIS_TREADY,
+
+    input SAMPLE_CLK,                   // sample clock (sample clock domain)
+    input ENABLE,                       // pop one word per sample
+    output reg [31:0] SAMPLE = 0,
+    output [ADDR_WIDTH:0] LEVEL,
+    output reg [31:0] UNDERRUNS = 0
+);
+    (* ram_style = "block" *) reg [31:0] fifo [0:2**ADDR_WIDTH-1];
+    reg [ADDR_WIDTH:0] wr_ptr = 0, rd_ptr = 0;
+
+    assign LEVEL = wr_ptr - rd_ptr;
+    wire full = LEVEL[ADDR_WIDTH];
+    wire empty = (LEVEL == 0);
+
+    assign S_AXIS_TREADY = ~full & ~FLUSH & RESETN;
+    wire push = S_AXIS_TVALID & S_AXIS_TREADY;
+
+    reg [2:0] sample_sync = 0;
+    wire sample_edge = sample_sync[1] & ~sample_sync[2];
+    wire pop = sample_edge & ENABLE & ~empty;
+
+    always @ (posedge CLK)
+        if (push)
+            fifo[wr_ptr[ADDR_WIDTH-1:0]] <= S_AXIS_TDATA;
+
+    always @ (posedge CLK)
+    begin
+        sample_sync <= {sample_sync[1:0], SAMPLE_CLK};
+
+        if (~RESETN || FLUSH)
+        begin
+            wr_ptr <= 0;
+            rd_ptr <= 0;
+            SAMPLE <= 32'b0;
+        end
+        else
+        begin
+            if (push)
+                wr_ptr <= wr_ptr + 1;
+            if (pop)
+            begin
+                SAMPLE <= fifo[rd_ptr[ADDR_WIDTH-1:0]];
+                rd_ptr <= rd_ptr + 1;
+            end
+        end
+
+        if (~RESETN || CLEAR)
+            UNDERRUNS <= 0;
+        else if (sample_edge && ENABLE && empty)
+            UNDERRUNS <= UNDERRUNS + 1;
+    end
+endmodule
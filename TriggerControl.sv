@@ -0,0 +1,99 @@
+`timescale 1ns / 1ps
+//////////////////////////////////////////////////////////////////////////////////
+// Company:
+// Engineer:
+//
+// Create Date: 10/19/2026 11:02:15 AM
+// Design Name:
+// Module Name: TriggerControl
+// Project Name:
+// Target Devices:
+// Tool Versions:
+// Description: Externally triggered bursts. An armed channel is held off until
+//              a trigger edge, runs one CYCLES-length burst and re-arms itself
+//              when the burst is done. Triggers are sampled on the sample
+//              clock, so trigger-to-output latency is a fixed number of
+//              sample clocks (synchronizer + gate + output register).
+//
+// Dependencies:
+//
+// Revision:
+// Revision 0.01 - File Created
+// Additional Comments:
+//
+//////////////////////////////////////////////////////////////////////////////////
+
+
+module TriggerControl(
+    input CLK,                  // sample clock
+    input [1:0] ARM,            // per channel, bursts wait for a trigger
+    input [1:0] SOURCE,         // 0 = software, 1 = trigger pin, 2 = sync input
+    input FALLING,              // 0 = rising edge, 1 = falling edge
+    input SOFT,                 // toggles once per software trigger (AXI clock domain)
+    input CLEAR,                // toggles once per counter clear (AXI clock domain)
+    input TRIG_IN,
+    input SYNC_IN,
+    input [31:0] HOLDOFF,       // sample clocks after a trigger before the next is accepted
+    input [1:0] DONE,           // burst finished, per channel
+    output [1:0] GATE,          // ANDed with RUN
+    output reg [31:0] COUNT = 0,
+    output reg [31:0] MISSED = 0
+);
+    localparam SOFTWARE = 2'd0, PIN = 2'd1, SYNC = 2'd2;
+
+    reg [2:0] pin_sync = 0, sync_sync = 0, soft_sync = 0, clear_sync = 0;
+    reg [1:0] firing = 0;
+    reg [31:0] holdoff = 0;
+
+    wire pin_edge  = FALLING ? (pin_sync[2] & ~pin_sync[1]) : (pin_sync[1] & ~pin_sync[2]);
+    wire sync_edge = FALLING ? (sync_sync[2] & ~sync_sync[1]) : (sync_sync[1] & ~sync_sync[2]);
+    wire soft_edge = soft_sync[2] ^ soft_sync[1];
+    wire clear     = clear_sync[2] ^ clear_sync[1];
+
+    reg trigger;
+    always_comb
+        case (SOURCE)
+            SOFTWARE: trigger = soft_edge;
+            PIN:      trigger = pin_edge;
+            SYNC:     trigger = sync_edge;
+            default:  trigger = 1'b0;
+        endcase
+
+    // A trigger is missed while an armed channel is still in its burst or the
+    // holdoff time has not expired
+    wire busy = ((firing & ARM) != 2'b0) || (holdoff != 0);
+    wire accept = (ARM != 2'b0) && trigger && ~busy;
+
+    always @ (posedge CLK)
+    begin
+        pin_sync <= {pin_sync[1:0], TRIG_IN};
+        sync_sync <= {sync_sync[1:0], SYNC_IN};
+        soft_sync <= {soft_sync[1:0], SOFT};
+        clear_sync <= {clear_sync[1:0], CLEAR};
+
+        if (accept)
+        begin
+            firing <= ARM;
+            holdoff <= HOLDOFF;
+        end
+        else
+        begin
+            // re-arm once the burst is done
+            firing <= firing & ARM & ~DONE;
+            if (holdoff != 0)
+                holdoff <= holdoff - 1;
+        end
+
+        if (clear)
+        begin
+            COUNT <= 0;
+            MISSED <= 0;
+        end
+        else if (accept)
+            COUNT <= COUNT + 1;
+        else if (trigger && ARM != 2'b0)
+            MISSED <= MISSED + 1;
+    end
+
+    assign GATE = ~ARM | firing;
+endmodule
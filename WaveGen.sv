@@ -96,16 +96,20 @@ module WaveGen(
 
     wire [11:0] DACA_out, DACB_out;
     wire SDI, CS, LDAC, SCK;
-    assign GPIO = {4'b0, LDAC, SDI, SCK, CS, 16'b0};
+    wire SYNC_OUT;
+    
+    // GPIO[22] is the burst trigger input
+    // GPIO[21] is the multi-board sync input, GPIO[20] the sync output
+    assign GPIO = {1'b0, 1'bz, 1'bz, SYNC_OUT, LDAC, SDI, SCK, CS, 16'b0};
     
     // Instantiate DACs
     // Ik's config
-    voltsToDACWords #(.DAC_TWOPOINTFIVE(135), .DAC_ZERO(2079)) DACA(OUT_A, DACA_out);
-    voltsToDACWords #(.DAC_TWOPOINTFIVE(134), .DAC_ZERO(2071)) DACB(OUT_B, DACB_out);
+    voltsToDACWords #(.DAC_TWOPOINTFIVE(135), .DAC_ZERO(2079)) DACA(CLK100, OUT_A, DACA_out);
+    voltsToDACWords #(.DAC_TWOPOINTFIVE(134), .DAC_ZERO(2071)) DACB(CLK100, OUT_B, DACB_out);
     
     // Athiya's config
-//    voltsToDACWords #(.DAC_TWOPOINTFIVE(34), .DAC_ZERO(2086)) DACA(OUT_A, DACA_out);
-//    voltsToDACWords #(.DAC_TWOPOINTFIVE(100), .DAC_ZERO(2069)) DACB(OUT_B, DACB_out);
+//    voltsToDACWords #(.DAC_TWOPOINTFIVE(34), .DAC_ZERO(2086)) DACA(CLK100, OUT_A, DACA_out);
+//    voltsToDACWords #(.DAC_TWOPOINTFIVE(100), .DAC_ZERO(2069)) DACB(CLK100, OUT_B, DACB_out);
     
     DAC_Controller controller(DACA_out, DACB_out, CLK100, CS, SCK, SDI, LDAC);  
     
@@ -134,6 +138,9 @@ module WaveGen(
         .FIXED_IO_ps_porb(FIXED_IO_ps_porb),
         .FIXED_IO_ps_srstb(FIXED_IO_ps_srstb),
         .OUT_A_0(OUT_A),
-        .OUT_B_0(OUT_B)
+        .OUT_B_0(OUT_B),
+        .SYNC_IN_0(GPIO[21]),
+        .SYNC_OUT_0(SYNC_OUT),
+        .TRIG_IN_0(GPIO[22])
     );
 endmodule
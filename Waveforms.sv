@@ -21,7 +21,10 @@
 
 module WaveForms 
 #(
-    parameter int SAMPLING_FREQUENCY = 50000
+    parameter int SAMPLING_FREQUENCY = 50000,
+    parameter int LUT_ADDR_WIDTH = 9,
+    parameter int LUT_DATA_WIDTH = 16,
+    parameter LUT_FILE = "sin_LUT.mem"
 )(
     input CLK,
     input LUT_CLK,
@@ -36,29 +39,42 @@ module WaveForms
     input [15:0] DTCYC_B,
     input signed [15:0] PHASE_OFFS_A,
     input signed [15:0] PHASE_OFFS_B,
-    input [15:0] CYCLES_A,
-    input [15:0] CYCLES_B,
+    input [31:0] CYCLES_A,
+    input [31:0] CYCLES_B,
+    input [15:0] STOP_A,
+    input [15:0] STOP_B,
+    input [1:0] NOISE_SHAPE_A,
+    input [1:0] NOISE_SHAPE_B,
+    input [31:0] NOISE_SEED_A,
+    input [31:0] NOISE_SEED_B,
     
     output reg signed [15:0] WAVE_A,
-    output reg signed [15:0] WAVE_B
+    output reg signed [15:0] WAVE_B,
+    output reg DONE_A = 0,
+    output reg DONE_B = 0
 );
-    localparam DC = 4'd0, SINE = 4'd1, SAWTOOTH = 4'd2, TRIANGLE = 4'd3, SQUARE = 4'd4;
+    localparam DC = 4'd0, SINE = 4'd1, SAWTOOTH = 4'd2, TRIANGLE = 4'd3, SQUARE = 4'd4, NOISE = 4'd6;
     localparam ONE_VOLT = 2**15 - 1;
     
-    reg  [31:0] phase_a = 0;
-    wire [31:0] delta_phase_a = ({FREQ_A, 32'b0})/SAMPLING_FREQUENCY;
+    // Phase increments and offsets (-180 to 180 degrees) from the settings,
+    // reciprocal multiplies on the fast clock instead of dividers
+    wire [31:0] delta_phase_a, delta_phase_b;
+    wire signed [31:0] normalized_phase_offset_a, normalized_phase_offset_b;
+    PhaseScale #(.SAMPLING_FREQUENCY(SAMPLING_FREQUENCY)) scale_a(LUT_CLK, FREQ_A, PHASE_OFFS_A, delta_phase_a, normalized_phase_offset_a);
+    PhaseScale #(.SAMPLING_FREQUENCY(SAMPLING_FREQUENCY)) scale_b(LUT_CLK, FREQ_B, PHASE_OFFS_B, delta_phase_b, normalized_phase_offset_b);
     
-    wire signed [31:0] normalized_phase_offset_a = ({PHASE_OFFS_A, 30'b0})/9000; // phase offset is from -180 degrees to 180 degrees
+    reg  [31:0] phase_a = 0;
     wire [31:0] real_phase_a = phase_a + normalized_phase_offset_a; 
          
     reg [31:0] phase_b = 0;
-    wire [31:0] delta_phase_b = ({FREQ_B, 32'b0})/SAMPLING_FREQUENCY;
-      
-    wire signed [31:0] normalized_phase_offset_b = ({PHASE_OFFS_B, 30'b0})/9000; // phase offset is from -180 degrees to 180 degrees
     wire [31:0] real_phase_b = phase_b + normalized_phase_offset_b;
     
     wire signed [15:0] sine_a, sine_b;
-    SineWaves(CLK, LUT_CLK, 1'b1, real_phase_a, real_phase_b, sine_a, sine_b);
+    SineWaves #(
+        .LUT_ADDR_WIDTH(LUT_ADDR_WIDTH),
+        .LUT_DATA_WIDTH(LUT_DATA_WIDTH),
+        .LUT_FILE(LUT_FILE)
+    ) sines(CLK, LUT_CLK, 1'b1, real_phase_a, real_phase_b, sine_a, sine_b);
     
     wire [31:0] dtcyca = {DTCYC_A, 16'b0}; 
     wire [31:0] dtcycb = {DTCYC_B, 16'b0}; 
@@ -74,21 +90,31 @@ module WaveForms
 //        .probe_in6({WAVE_A, WAVE_B})
 //   ); 
       
-    reg [15:0] n_cycles_a = 0;
-    always @ (negedge phase_a[31] or negedge ENA)
-        if (ENA == 1'b0)
-            n_cycles_a <= 0;
-        else if (n_cycles_a != CYCLES_A)
-            n_cycles_a <= n_cycles_a + 1;
+    // Bursts count carries out of the phase accumulator itself, so the count
+    // does not depend on the phase offset. A burst stops STOP_A/2**16 of a
+    // cycle after CYCLES_A whole cycles; both 0 runs forever. done_a stops
+    // the accumulator, DONE_A is registered with WAVE_A so the last sample
+    // of the burst is still output.
+    reg [32:0] n_cycles_a = 0;
+    wire [32:0] next_phase_a = phase_a + delta_phase_a;
+    wire done_a = (CYCLES_A != 0 || STOP_A != 0) &&
+                  (n_cycles_a > CYCLES_A || (n_cycles_a == CYCLES_A && phase_a >= {STOP_A, 16'b0}));
+    
+    // Noise is reseeded while the channel is stopped, so every run repeats
+    wire signed [15:0] noise_a;
+    NoiseGen noise_gen_a(CLK, ~ENA, MODE_A == NOISE && ~done_a, NOISE_SEED_A, NOISE_SHAPE_A, noise_a);
   
     always @ (posedge CLK)
         if (ENA == 1'b0)
         begin
             phase_a <= 32'b0;
+            n_cycles_a <= 0;
             WAVE_A <= 16'b0;
+            DONE_A <= 1'b0;
         end
-        else if (CYCLES_A == 0 || n_cycles_a != CYCLES_A)     
+        else if (~done_a)
         begin
+            DONE_A <= 1'b0;
             case (MODE_A)
                 DC:
                     WAVE_A <= 0;
@@ -116,27 +142,37 @@ module WaveForms
                         WAVE_A <= -ONE_VOLT;
                     else 
                         WAVE_A <= ONE_VOLT;
+                NOISE:
+                    WAVE_A <= noise_a;
             endcase
-            phase_a <= phase_a + delta_phase_a;
+            phase_a <= next_phase_a[31:0];
+            n_cycles_a <= n_cycles_a + next_phase_a[32];
         end
         else
+        begin
             WAVE_A <= 16'b0;
+            DONE_A <= 1'b1;
+        end
 
-    reg [15:0] n_cycles_b = 0;        
-    always @ (negedge phase_b[31])
-        if (ENB == 1'b0)
-            n_cycles_b <= 0;
-        else if (n_cycles_b != CYCLES_B)
-            n_cycles_b <= n_cycles_b + 1;          
+    reg [32:0] n_cycles_b = 0;
+    wire [32:0] next_phase_b = phase_b + delta_phase_b;
+    wire done_b = (CYCLES_B != 0 || STOP_B != 0) &&
+                  (n_cycles_b > CYCLES_B || (n_cycles_b == CYCLES_B && phase_b >= {STOP_B, 16'b0}));
+    
+    wire signed [15:0] noise_b;
+    NoiseGen noise_gen_b(CLK, ~ENB, MODE_B == NOISE && ~done_b, NOISE_SEED_B, NOISE_SHAPE_B, noise_b);
 
     always @ (posedge CLK)
     if (ENB == 1'b0)
     begin
         phase_b <= 32'b0;
+        n_cycles_b <= 0;
         WAVE_B <= 16'b0;
+        DONE_B <= 1'b0;
     end
-    else if (CYCLES_B == 0 || n_cycles_b != CYCLES_B)     
+    else if (~done_b)
     begin
+        DONE_B <= 1'b0;
         case (MODE_B)
             DC:
                 WAVE_B <= 0;
@@ -164,10 +200,16 @@ module WaveForms
                     WAVE_B <= -ONE_VOLT;
                 else 
                     WAVE_B <= ONE_VOLT;
+            NOISE:
+                WAVE_B <= noise_b;
         endcase
-        phase_b <= phase_b + delta_phase_b;
+        phase_b <= next_phase_b[31:0];
+        n_cycles_b <= n_cycles_b + next_phase_b[32];
     end
     else
+    begin
         WAVE_B <= 16'b0;
+        DONE_B <= 1'b1;
+    end
             
 endmodule
\ No newline at end of file
@@ -32,8 +32,29 @@ module voltsToDACWords
     parameter int DAC_TWOPOINTFIVE = 1, DAC_ZERO = 2048, //ideal conditions, please modify accordingly
     parameter N = 16, M = 12
 )(
+    input CLK,
     input signed [N-1:0] in,
-    output [M-1:0] calibrated
+    output reg [M-1:0] calibrated = DAC_ZERO
 );    
-    assign calibrated = ($signed(DAC_TWOPOINTFIVE - DAC_ZERO)*in + 12500)/25000 + DAC_ZERO;
+    // calibrated = round(in*(DAC_TWOPOINTFIVE - DAC_ZERO)/25000) + DAC_ZERO, the
+    // divide folded into a gain with GAIN_SHIFT fraction bits, registered in
+    // two stages (DSP multiply, then round, offset and clamp to the DAC range)
+    localparam int GAIN_SHIFT = 24;
+    localparam longint SPAN = DAC_TWOPOINTFIVE - DAC_ZERO;
+    localparam longint GAIN = ((SPAN <<< GAIN_SHIFT) + (SPAN < 0 ? -12500 : 12500)) / 25000;
+    localparam longint DAC_MAX = 2**M - 1;
+    
+    (* use_dsp = "yes" *) reg signed [47:0] scaled = 0;
+    wire signed [47:0] word = ((scaled + (48'sd1 <<< (GAIN_SHIFT-1))) >>> GAIN_SHIFT) + DAC_ZERO;
+    
+    always @ (posedge CLK)
+    begin
+        scaled <= in * 48'(GAIN);
+        if (word < 0)
+            calibrated <= 0;
+        else if (word > DAC_MAX)
+            calibrated <= DAC_MAX[M-1:0];
+        else
+            calibrated <= word[M-1:0];
+    end
 endmodule
@@ -1,25 +1,188 @@
+"""Quarter-wave sine LUT generator for SineWaves (sine.sv).
+
+Writes the table as a Xilinx .coe, a $readmemh .mem and a C++ constexpr
+header from the same values, and reports the worst-case amplitude error and
+predicted SFDR of the 16-bit output the hardware builds from it.
+
+    python coe.py                     # 512 x 16, writes sin_LUT.coe/.mem/.h
+    python coe.py -a 10 -w 18         # 1024 x 18
+    python coe.py -a 6 7 8 9 10 -w 12 14 16 --report-only
+"""
+
+import argparse
+import cmath
 import math
 
-### VARIABLES #####
-outfile = "sin_LUT.coe"
-lut_width = 16
-num_divisions = 512
-stop_point = math.pi/2
-#####        #######
+OUT_WIDTH = 16          # width of the datapath after SineWaves
+PHASE_WIDTH = 32        # phase accumulator width
+
+
+def make_table(addr_bits, width, half_step, exact=False):
+    """Magnitudes of sin over [0, pi/2), full scale 2**(width-1) - 1."""
+    depth = 1 << addr_bits
+    delta = (math.pi / 2) / depth
+    full_scale = (1 << (width - 1)) - 1
+    shift = 0.5 if half_step else 0.0
+    values = [math.sin((i + shift) * delta) * full_scale for i in range(depth)]
+    return values if exact else [round(v) for v in values]
+
+
+def to_datapath(value, width):
+    """LUT entry rescaled to the 16-bit datapath, as SineWaves does."""
+    if width >= OUT_WIDTH:
+        return value >> (width - OUT_WIDTH)
+    return value << (OUT_WIDTH - width)
+
+
+def reconstruct(table, addr_bits, width):
+    """One full cycle, one sample per (addr_bits + 2)-bit phase code."""
+    depth = 1 << addr_bits
+    wave = []
+    for code in range(4 * depth):
+        sign = code >> (addr_bits + 1) & 1
+        mirror = code >> addr_bits & 1
+        index = code & (depth - 1)
+        value = to_datapath(table[(depth - 1 - index) if mirror else index], width)
+        wave.append(-value if sign else value)
+    return wave
+
+
+def fft(x):
+    """Iterative radix-2 FFT, len(x) must be a power of two."""
+    n = len(x)
+    a = [complex(v) for v in x]
+    j = 0
+    for i in range(1, n):
+        bit = n >> 1
+        while j & bit:
+            j ^= bit
+            bit >>= 1
+        j |= bit
+        if i < j:
+            a[i], a[j] = a[j], a[i]
+    size = 2
+    while size <= n:
+        w_step = cmath.exp(-2j * math.pi / size)
+        half = size // 2
+        for start in range(0, n, size):
+            w = 1
+            for k in range(half):
+                t = w * a[start + k + half]
+                a[start + k + half] = a[start + k] - t
+                a[start + k] += t
+                w *= w_step
+        size *= 2
+    return a
+
+
+def analyze(table, addr_bits, width, half_step):
+    """Worst-case errors and SFDR estimates (dBc).
+
+    Rounding error is in LSB of the table, output error in LSB of the 16-bit
+    output against the ideal sine at each phase code.
+    """
+    ideal = make_table(addr_bits, width, half_step, exact=True)
+    rounding = max(abs(v - x) for v, x in zip(table, ideal))
+
+    wave = reconstruct(table, addr_bits, width)
+    n = len(wave)
+    full_scale = (1 << (OUT_WIDTH - 1)) - 1
+
+    # The phase code selects the angle at the start of its step
+    worst = max(abs(v - full_scale * math.sin(2 * math.pi * k / n)) for k, v in enumerate(wave))
+
+    # Spurs of the table itself: one cycle, fundamental in bin 1, skip DC
+    spectrum = [abs(c) for c in fft(wave)[: n // 2]]
+    fundamental = spectrum[1]
+    spur = max(spectrum[2:]) if n > 4 else 0.0
+    table_sfdr = 20 * math.log10(fundamental / spur) if spur > 0 else float("inf")
+
+    # Truncating the phase to addr_bits + 2 bits bounds the SFDR for tuning
+    # words that do not divide the accumulator evenly
+    truncation_sfdr = 6.02 * (addr_bits + 2) if addr_bits + 2 < PHASE_WIDTH else float("inf")
+
+    return rounding, worst, table_sfdr, min(table_sfdr, truncation_sfdr)
+
+
+def write_coe(path, table, width):
+    digits = math.ceil(width / 4)
+    with open(path, "w") as f:
+        f.write("memory_initialization_radix=16;\n")
+        f.write("memory_initialization_vector=\n")
+        for i, value in enumerate(table):
+            delim = "" if i == len(table) - 1 else ","
+            f.write(f"{value:0{digits}X}{delim}\n")
+        f.write(";\n")
+
+
+def write_mem(path, table, width):
+    digits = math.ceil(width / 4)
+    with open(path, "w") as f:
+        for value in table:
+            f.write(f"{value:0{digits}X}\n")
+
+
+def write_header(path, table, addr_bits, width, half_step):
+    ctype = "uint16_t" if width <= 16 else "uint32_t"
+    digits = math.ceil(width / 4)
+    with open(path, "w") as f:
+        f.write("// WAVEGEN IP Example\n")
+        f.write(f"// Quarter-wave sine table ({path.split('/')[-1]})\n\n")
+        f.write(f"// Generated by coe.py -a {addr_bits} -w {width}{' --half-step' if half_step else ''}, do not edit.\n")
+        f.write("// Same values as the .coe and .mem images loaded by SineWaves (sine.sv).\n\n")
+        f.write("#ifndef SIN_LUT_H\n#define SIN_LUT_H\n\n#include <cstdint>\n\n")
+        f.write(f"constexpr int SIN_LUT_ADDR_WIDTH = {addr_bits};\n")
+        f.write(f"constexpr int SIN_LUT_DATA_WIDTH = {width};\n\n")
+        f.write(f"constexpr {ctype} SIN_LUT[{len(table)}] =\n{{\n")
+        for i in range(0, len(table), 8):
+            row = ", ".join(f"0x{v:0{digits}X}" for v in table[i:i + 8])
+            f.write(f"    {row}{',' if i + 8 < len(table) else ''}\n")
+        f.write("};\n\n#endif // SIN_LUT_H\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sine LUT generator for SineWaves (sine.sv)")
+    parser.add_argument("-a", "--addr-bits", type=int, nargs="+", default=[9],
+                        help="LUT_ADDR_WIDTH, quarter-wave depth is 2**A (default 9)")
+    parser.add_argument("-w", "--width", type=int, nargs="+", default=[16],
+                        help="LUT_DATA_WIDTH (default 16)")
+    parser.add_argument("-o", "--output", default="sin_LUT",
+                        help="output path without extension (default sin_LUT)")
+    parser.add_argument("--half-step", action="store_true",
+                        help="sample at the middle of each step so the mirrored quadrants "
+                             "line up (lower spurs, not the table the bitstream ships with)")
+    parser.add_argument("--report-only", action="store_true",
+                        help="print the error report without writing files")
+    args = parser.parse_args()
+
+    for a in args.addr_bits:
+        if not 2 <= a <= 16:
+            parser.error(f"address width {a} out of range 2 to 16")
+    for w in args.width:
+        if not 2 <= w <= 32:
+            parser.error(f"data width {w} out of range 2 to 32")
 
-lut_width_hex = math.ceil(lut_width/4) # width of each LUT element when written in hex (for getting leading zeros)
-bit_mask = (1 << lut_width) - 1 # all ones
-delta = stop_point/num_divisions
+    sizes = [(a, w) for a in args.addr_bits for w in args.width]
+    if len(sizes) > 1 and not args.report_only:
+        parser.error("several sizes given, add --report-only or pick one")
 
-with open(outfile, "w") as f:
-    f.write("memory_initialization_radix=16;\n")
-    f.write("memory_initialization_vector=\n")
+    print(f"{'depth':>7} {'width':>5} {'bits':>7} {'rounding':>10} {'output err':>10} {'table SFDR':>11} {'SFDR':>8}")
+    for a, w in sizes:
+        table = make_table(a, w, args.half_step)
+        rounding, worst, table_sfdr, sfdr = analyze(table, a, w, args.half_step)
+        bits = (1 << a) * w
+        print(f"{1 << a:>7} {w:>5} {bits:>7} {rounding:>6.2f} LSB {worst:>6.2f} LSB"
+              f" {table_sfdr:>7.1f} dBc {sfdr:>4.1f} dBc")
 
-    for i in range(num_divisions):
-        sin_value = math.sin(i*delta)
-        value = round(sin_value*(2**(lut_width-1) - 1)) # convert to fixed point
+    if not args.report_only:
+        a, w = sizes[0]
+        table = make_table(a, w, args.half_step)
+        write_coe(args.output + ".coe", table, w)
+        write_mem(args.output + ".mem", table, w)
+        write_header(args.output + ".h", table, a, w, args.half_step)
+        print(f"Wrote {args.output}.coe, {args.output}.mem and {args.output}.h"
+              f" (set LUT_ADDR_WIDTH = {a}, LUT_DATA_WIDTH = {w})")
 
-        delim = "" if i == num_divisions-1 else ","
-        f.write("{0:0"f"{lut_width_hex}""X}{1}\n".format(value & bit_mask, delim)) # we and with bit mask because we want unsigned values only (python problem)
 
-    f.write(";\n")
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+// WAVEGEN IP Example
+// Quarter-wave sine table (sin_LUT.h)
+
+// Generated by coe.py -a 9 -w 16, do not edit.
+// Same values as the .coe and .mem images loaded by SineWaves (sine.sv).
+
+#ifndef SIN_LUT_H
+#define SIN_LUT_H
+
+#include <cstdint>
+
+constexpr int SIN_LUT_ADDR_WIDTH = 9;
+constexpr int SIN_LUT_DATA_WIDTH = 16;
+
+constexpr uint16_t SIN_LUT[512] =
+{
+    0x0000, 0x0065, 0x00C9, 0x012E, 0x0192, 0x01F7, 0x025B, 0x02C0,
+    0x0324, 0x0389, 0x03ED, 0x0452, 0x04B6, 0x051B, 0x057F, 0x05E3,
+    0x0648, 0x06AC, 0x0711, 0x0775, 0x07D9, 0x083E, 0x08A2, 0x0906,
+    0x096A, 0x09CF, 0x0A33, 0x0A97, 0x0AFB, 0x0B5F, 0x0BC4, 0x0C28,
+    0x0C8C, 0x0CF0, 0x0D54, 0x0DB8, 0x0E1C, 0x0E80, 0x0EE3, 0x0F47,
+    0x0FAB, 0x100F, 0x1072, 0x10D6, 0x113A, 0x119D, 0x1201, 0x1264,
+    0x12C8, 0x132B, 0x138F, 0x13F2, 0x1455, 0x14B9, 0x151C, 0x157F,
+    0x15E2, 0x1645, 0x16A8, 0x170B, 0x176E, 0x17D0, 0x1833, 0x1896,
+    0x18F9, 0x195B, 0x19BE, 0x1A20, 0x1A82, 0x1AE5, 0x1B47, 0x1BA9,
+    0x1C0B, 0x1C6D, 0x1CCF, 0x1D31, 0x1D93, 0x1DF5, 0x1E57, 0x1EB8,
+    0x1F1A, 0x1F7B, 0x1FDD, 0x203E, 0x209F, 0x2100, 0x2161, 0x21C2,
+    0x2223, 0x2284, 0x22E5, 0x2346, 0x23A6, 0x2407, 0x2467, 0x24C8,
+    0x2528, 0x2588, 0x25E8, 0x2648, 0x26A8, 0x2708, 0x2767, 0x27C7,
+    0x2826, 0x2886, 0x28E5, 0x2944, 0x29A3, 0x2A02, 0x2A61, 0x2AC0,
+    0x2B1F, 0x2B7D, 0x2BDC, 0x2C3A, 0x2C99, 0x2CF7, 0x2D55, 0x2DB3,
+    0x2E11, 0x2E6E, 0x2ECC, 0x2F2A, 0x2F87, 0x2FE4, 0x3041, 0x309E,
+    0x30FB, 0x3158, 0x31B5, 0x3211, 0x326E, 0x32CA, 0x3326, 0x3383,
+    0x33DF, 0x343A, 0x3496, 0x34F2, 0x354D, 0x35A8, 0x3604, 0x365F,
+    0x36BA, 0x3715, 0x376F, 0x37CA, 0x3824, 0x387E, 0x38D9, 0x3933,
+    0x398C, 0x39E6, 0x3A40, 0x3A99, 0x3AF2, 0x3B4C, 0x3BA5, 0x3BFE,
+    0x3C56, 0x3CAF, 0x3D07, 0x3D60, 0x3DB8, 0x3E10, 0x3E68, 0x3EBF,
+    0x3F17, 0x3F6E, 0x3FC5, 0x401D, 0x4073, 0x40CA, 0x4121, 0x4177,
+    0x41CE, 0x4224, 0x427A, 0x42D0, 0x4325, 0x437B, 0x43D0, 0x4425,
+    0x447A, 0x44CF, 0x4524, 0x4578, 0x45CD, 0x4621, 0x4675, 0x46C9,
+    0x471C, 0x4770, 0x47C3, 0x4816, 0x4869, 0x48BC, 0x490F, 0x4961,
+    0x49B4, 0x4A06, 0x4A58, 0x4AA9, 0x4AFB, 0x4B4C, 0x4B9D, 0x4BEE,
+    0x4C3F, 0x4C90, 0x4CE0, 0x4D31, 0x4D81, 0x4DD1, 0x4E20, 0x4E70,
+    0x4EBF, 0x4F0E, 0x4F5D, 0x4FAC, 0x4FFB, 0x5049, 0x5097, 0x50E5,
+    0x5133, 0x5181, 0x51CE, 0x521B, 0x5268, 0x52B5, 0x5302, 0x534E,
+    0x539B, 0x53E7, 0x5432, 0x547E, 0x54C9, 0x5515, 0x5560, 0x55AA,
+    0x55F5, 0x563F, 0x568A, 0x56D3, 0x571D, 0x5767, 0x57B0, 0x57F9,
+    0x5842, 0x588B, 0x58D3, 0x591C, 0x5964, 0x59AC, 0x59F3, 0x5A3B,
+    0x5A82, 0x5AC9, 0x5B0F, 0x5B56, 0x5B9C, 0x5BE2, 0x5C28, 0x5C6E,
+    0x5CB3, 0x5CF9, 0x5D3E, 0x5D82, 0x5DC7, 0x5E0B, 0x5E4F, 0x5E93,
+    0x5ED7, 0x5F1A, 0x5F5D, 0x5FA0, 0x5FE3, 0x6025, 0x6068, 0x60AA,
+    0x60EB, 0x612D, 0x616E, 0x61AF, 0x61F0, 0x6231, 0x6271, 0x62B1,
+    0x62F1, 0x6331, 0x6370, 0x63AF, 0x63EE, 0x642D, 0x646C, 0x64AA,
+    0x64E8, 0x6525, 0x6563, 0x65A0, 0x65DD, 0x661A, 0x6656, 0x6693,
+    0x66CF, 0x670A, 0x6746, 0x6781, 0x67BC, 0x67F7, 0x6832, 0x686C,
+    0x68A6, 0x68E0, 0x6919, 0x6952, 0x698B, 0x69C4, 0x69FD, 0x6A35,
+    0x6A6D, 0x6AA4, 0x6ADC, 0x6B13, 0x6B4A, 0x6B81, 0x6BB7, 0x6BED,
+    0x6C23, 0x6C59, 0x6C8E, 0x6CC3, 0x6CF8, 0x6D2D, 0x6D61, 0x6D95,
+    0x6DC9, 0x6DFD, 0x6E30, 0x6E63, 0x6E96, 0x6EC8, 0x6EFB, 0x6F2C,
+    0x6F5E, 0x6F90, 0x6FC1, 0x6FF2, 0x7022, 0x7053, 0x7083, 0x70B2,
+    0x70E2, 0x7111, 0x7140, 0x716F, 0x719D, 0x71CB, 0x71F9, 0x7227,
+    0x7254, 0x7281, 0x72AE, 0x72DB, 0x7307, 0x7333, 0x735E, 0x738A,
+    0x73B5, 0x73E0, 0x740A, 0x7435, 0x745F, 0x7488, 0x74B2, 0x74DB,
+    0x7504, 0x752D, 0x7555, 0x757D, 0x75A5, 0x75CC, 0x75F3, 0x761A,
+    0x7641, 0x7667, 0x768D, 0x76B3, 0x76D8, 0x76FE, 0x7722, 0x7747,
+    0x776B, 0x778F, 0x77B3, 0x77D7, 0x77FA, 0x781D, 0x783F, 0x7862,
+    0x7884, 0x78A5, 0x78C7, 0x78E8, 0x7909, 0x7929, 0x794A, 0x796A,
+    0x7989, 0x79A9, 0x79C8, 0x79E6, 0x7A05, 0x7A23, 0x7A41, 0x7A5F,
+    0x7A7C, 0x7A99, 0x7AB6, 0x7AD2, 0x7AEE, 0x7B0A, 0x7B26, 0x7B41,
+    0x7B5C, 0x7B77, 0x7B91, 0x7BAB, 0x7BC5, 0x7BDE, 0x7BF8, 0x7C10,
+    0x7C29, 0x7C41, 0x7C59, 0x7C71, 0x7C88, 0x7C9F, 0x7CB6, 0x7CCD,
+    0x7CE3, 0x7CF9, 0x7D0E, 0x7D24, 0x7D39, 0x7D4D, 0x7D62, 0x7D76,
+    0x7D89, 0x7D9D, 0x7DB0, 0x7DC3, 0x7DD5, 0x7DE8, 0x7DFA, 0x7E0B,
+    0x7E1D, 0x7E2E, 0x7E3E, 0x7E4F, 0x7E5F, 0x7E6F, 0x7E7E, 0x7E8D,
+    0x7E9C, 0x7EAB, 0x7EB9, 0x7EC7, 0x7ED5, 0x7EE2, 0x7EEF, 0x7EFC,
+    0x7F09, 0x7F15, 0x7F21, 0x7F2C, 0x7F37, 0x7F42, 0x7F4D, 0x7F57,
+    0x7F61, 0x7F6B, 0x7F74, 0x7F7D, 0x7F86, 0x7F8F, 0x7F97, 0x7F9F,
+    0x7FA6, 0x7FAD, 0x7FB4, 0x7FBB, 0x7FC1, 0x7FC7, 0x7FCD, 0x7FD2,
+    0x7FD8, 0x7FDC, 0x7FE1, 0x7FE5, 0x7FE9, 0x7FEC, 0x7FF0, 0x7FF3,
+    0x7FF5, 0x7FF7, 0x7FF9, 0x7FFB, 0x7FFD, 0x7FFE, 0x7FFE, 0x7FFF
+};
+
+#endif // SIN_LUT_H
@@ -9,7 +9,12 @@
 // Project Name: 
 // Target Devices: 
 // Tool Versions: 
-// Description: 
+// Description: Quarter-wave sine lookup for both channels. The top two phase
+//              bits pick the quadrant (sign and mirror) and the next
+//              LUT_ADDR_WIDTH bits address a 2**LUT_ADDR_WIDTH x LUT_DATA_WIDTH
+//              ROM loaded from LUT_FILE, so LUT_ADDR_WIDTH + 2 phase bits
+//              drive the output. Generate LUT_FILE (and the matching .coe and
+//              C++ table) with coe.py.
 // 
 // Dependencies: 
 // 
@@ -20,7 +25,12 @@
 //////////////////////////////////////////////////////////////////////////////////
 
 
-module SineWaves (
+module SineWaves
+#(
+    parameter int LUT_ADDR_WIDTH = 9,       // quarter-wave depth is 2**LUT_ADDR_WIDTH
+    parameter int LUT_DATA_WIDTH = 16,      // magnitude bits per entry, 2 to 32
+    parameter LUT_FILE = "sin_LUT.mem"      // $readmemh image from coe.py
+)(
     input CLK,
     input LUT_CLK,
     input EN,
@@ -31,7 +41,6 @@ module SineWaves (
     output reg signed [15:0] OUTA,
     output reg signed [15:0] OUTB    
 );
-    localparam LUT_ADDR_WIDTH = 9;    
     wire SIGN_A = PHASE_A[31];
     wire DIR_A = PHASE_A[30];
     wire [LUT_ADDR_WIDTH-1:0] LUTA_index = PHASE_A[29 -: LUT_ADDR_WIDTH];
@@ -42,28 +51,33 @@ module SineWaves (
     
     reg [LUT_ADDR_WIDTH-1:0] LUTA_addr;
     reg [LUT_ADDR_WIDTH-1:0] LUTB_addr;    
-    wire [15:0] LUTA_value, LUTB_value;
     
-    sin_LUT LUT (
-      .clka(LUT_CLK),    // input wire clka
-      //.ena(EN),      // input wire ena
-      .addra(LUTA_addr),  // input wire [8 : 0] addra
-      .douta(LUTA_value),  // output wire [15 : 0] douta
-      .clkb(LUT_CLK),    // input wire clkb
-      //.enb(EN),      // input wire enb
-      .addrb(LUTB_addr),  // input wire [8 : 0] addrb
-      .doutb(LUTB_value)  // output wire [15 : 0] doutb
-    );
+    // Dual-port ROM with registered outputs, same latency as the sin_LUT core
+    (* rom_style = "block" *) reg [LUT_DATA_WIDTH-1:0] LUT [0:2**LUT_ADDR_WIDTH-1];
+    reg [LUT_DATA_WIDTH-1:0] LUTA_data, LUTB_data;
+    initial $readmemh(LUT_FILE, LUT);
+    
+    always @ (posedge LUT_CLK)
+    begin
+        LUTA_data <= LUT[LUTA_addr];
+        LUTB_data <= LUT[LUTB_addr];
+    end
     
-//    vio_3 sine (
-//      .clk(LUT_CLK),              // input wire clk
-//      .probe_in0(PHASE_A[31 -: (LUT_ADDR_WIDTH+2)]),  // input wire [31 : 0] probe_in0
-//      .probe_in1(LUTA_addr),  // input wire [8 : 0] probe_in1
-//      .probe_in2(LUTB_addr),  // input wire [8 : 0] probe_in2
-//      .probe_in3(LUTA_value),  // input wire [15 : 0] probe_in3
-//      .probe_in4(PHASE_B[31 -: (LUT_ADDR_WIDTH+2)]),  // input wire [31 : 0] probe_in0
-//      .probe_in5(LUTB_value)
-//    );
+    // Entries are magnitudes with full scale at 2**(LUT_DATA_WIDTH-1) - 1,
+    // rescale to the 16-bit datapath
+    wire [15:0] LUTA_value, LUTB_value;
+    generate
+        if (LUT_DATA_WIDTH >= 16)
+        begin
+            assign LUTA_value = LUTA_data[LUT_DATA_WIDTH-1 -: 16];
+            assign LUTB_value = LUTB_data[LUT_DATA_WIDTH-1 -: 16];
+        end
+        else
+        begin
+            assign LUTA_value = {LUTA_data, {(16-LUT_DATA_WIDTH){1'b0}}};
+            assign LUTB_value = {LUTB_data, {(16-LUT_DATA_WIDTH){1'b0}}};
+        end
+    endgenerate
     
     always @ (posedge LUT_CLK)
     if (CLK == 1'b1)
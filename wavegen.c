@@ -21,13 +21,19 @@
 #include <stdbool.h>
 #include <stdio.h>           // printf
 #include <string.h>          // strcmp
+#include <unistd.h>          // usleep
 #include "wavegen_ip.h"         // IP library
+#include "wavegen_render.h"     // render
 
 int main(int argc, char* argv[])
 {
+    // wavegen render FILE SECONDS COMMAND [-- COMMAND ...], no hardware needed
+    if (argc >= 2 && strcmp(argv[1], "render") == 0)
+        return wavegenRender(argc - 1, argv + 1);
+
     if (!wavegenOpen())
     {
-        printf("Could not map an address for the wavegen IP, Are you running as root?\n");
+        printf("Could not map an address for the wavegen IP, is wavegen_driver loaded and /dev/wavegen accessible (or are you running as root)?\n");
         exit(EXIT_FAILURE);
     }
     char *channel = argv[2];
@@ -35,7 +41,10 @@ int main(int argc, char* argv[])
     if (argc == 2)
     {
         if (strcmp(argv[1], "run") == 0)
-            configureRun();
+        {
+            if (!configureRun())
+                printf("Could not arm sync, is the sample clock running?\n");
+        }
         else if (strcmp(argv[1], "stop") == 0)
             configureStop();
         else 
@@ -45,6 +54,60 @@ int main(int argc, char* argv[])
         // TODO: add arb command here
     }
 
+    // wavegen sync {off|master|slave|arm}
+    else if (argc == 3 && strcmp(argv[1], "sync") == 0)
+    {
+        if (strcmp(argv[2], "off") == 0)
+            configureSync(SYNC_OFF);
+        else if (strcmp(argv[2], "master") == 0)
+            configureSync(SYNC_MASTER);
+        else if (strcmp(argv[2], "slave") == 0)
+            configureSync(SYNC_SLAVE);
+        else if (strcmp(argv[2], "arm") == 0)
+            syncArm();
+        else
+            printf("  command not understood\n");
+    }
+
+    // wavegen trigger {fire|status|clear}
+    // wavegen trigger OUT off
+    // wavegen trigger OUT {soft|pin|sync} [rising|falling] [HOLDOFF]
+    else if (argc >= 3 && argc <= 6 && strcmp(argv[1], "trigger") == 0)
+    {
+        if (argc == 3 && strcmp(argv[2], "fire") == 0)
+            softwareTrigger();
+        else if (argc == 3 && strcmp(argv[2], "status") == 0)
+        {
+            uint32_t count, missed;
+            getTriggerCounts(&count, &missed);
+            printf("%u triggers, %u missed\n", count, missed);
+        }
+        else if (argc == 3 && strcmp(argv[2], "clear") == 0)
+            clearTriggerCounts();
+        else if (argc == 4 && strcmp(argv[3], "off") == 0)
+            disarmTrigger(channel);
+        else if (argc >= 4)
+        {
+            int source = -1;
+            if (strcmp(argv[3], "soft") == 0)
+                source = TRIGGER_SOFTWARE;
+            else if (strcmp(argv[3], "pin") == 0)
+                source = TRIGGER_PIN;
+            else if (strcmp(argv[3], "sync") == 0)
+                source = TRIGGER_SYNC;
+
+            bool falling = argc > 4 && strcmp(argv[4], "falling") == 0;
+            uint32_t holdoff = argc > 5 ? strtoul(argv[5], NULL, 0) : 0; // units of 1 sample
+
+            if (source >= 0)
+                configureTrigger(channel, source, falling, holdoff);
+            else
+                printf("  command not understood\n");
+        }
+        else
+            printf("  command not understood\n");
+    }
+
     else if (argc == 4 && (strcmp(argv[1], "DC") == 0 || strcmp(argv[1], "dc") == 0))
     {
      //wavegen DC OUT OFS  
@@ -52,20 +115,179 @@ int main(int argc, char* argv[])
         configureDC(channel, voltage);
     }
 
-    else if (argc == 4 && strcmp(argv[1], "cycles") == 0)
+    else if ((argc == 4 || argc == 5) && strcmp(argv[1], "cycles") == 0)
     {
         // wavegen cycles OUT, continuous
         if (strcmp(argv[3], "continuous") == 0)
         {
             setCycles(channel, 0);
+            setStopPhase(channel, 0);
         }
-        //wavegen cycles OUT, N
+        //wavegen cycles OUT, N [STOP_PHASE]
         else
         {
-            int cycles = atoi(argv[3]);
+            uint32_t cycles = strtoul(argv[3], NULL, 0); // 0 to 4294967295
+            uint16_t stopPhase = argc > 4 ? atoi(argv[4]) : 0; // 0 to 35999
             setCycles(channel, cycles);
+            setStopPhase(channel, stopPhase);
         }
     }
+
+    // wavegen automate OUT {amplitude|offset|frequency} {ramp|step|sine} FROM TO PERIOD RATE SECONDS [CPU] [PRIORITY]
+    else if (argc >= 10 && argc <= 12 && strcmp(argv[1], "automate") == 0)
+    {
+        int param = -1, curve = -1;
+        int32_t from = atoi(argv[5]);
+        int32_t to = atoi(argv[6]);
+        double period = atof(argv[7]) / 1000; // units of 1 ms
+        uint32_t rate = strtoul(argv[8], NULL, 0); // updates per second
+        double seconds = atof(argv[9]);
+        int cpu = argc > 10 ? atoi(argv[10]) : -1;
+        int priority = argc > 11 ? atoi(argv[11]) : 80;
+
+        if (strcmp(argv[3], "amplitude") == 0)
+            param = PARAM_AMPLITUDE;
+        else if (strcmp(argv[3], "offset") == 0)
+            param = PARAM_OFFSET;
+        else if (strcmp(argv[3], "frequency") == 0)
+            param = PARAM_FREQUENCY;
+
+        if (strcmp(argv[4], "ramp") == 0)
+            curve = CURVE_RAMP;
+        else if (strcmp(argv[4], "step") == 0)
+            curve = CURVE_STEP;
+        else if (strcmp(argv[4], "sine") == 0)
+            curve = CURVE_SINE;
+
+        if (param < 0 || curve < 0 || !automationAdd(channel, param, curve, from, to, period, NULL, 0))
+            printf("  command not understood\n");
+        else if (!automationStart(rate, cpu, priority))
+        {
+            printf("Could not start automation\n");
+            automationStop(NULL);
+        }
+        else
+        {
+            automationStats stats;
+            int i;
+
+            usleep(seconds * 1000000);
+            automationStop(&stats);
+
+            printf("%llu updates at %.1f/s (requested %u/s), %llu overruns\n",
+                (unsigned long long)stats.updates, stats.rate, rate, (unsigned long long)stats.overruns);
+            printf("Latency mean %.2fus, max %.2fus\n",
+                stats.updates ? stats.totalLatencyNs / 1000.0 / stats.updates : 0, stats.maxLatencyNs / 1000.0);
+            for (i = 0; i < AUTOMATION_HISTOGRAM_BINS; i++)
+                if (stats.histogram[i])
+                    printf("  %3d%s us: %u\n", i, i == AUTOMATION_HISTOGRAM_BINS - 1 ? "+" : " ", stats.histogram[i]);
+        }
+    }
+
+    // wavegen stream OUT AMP [OFS]
+    else if ((argc == 4 || argc == 5) && strcmp(argv[1], "stream") == 0)
+    {
+        uint16_t amplitude = atoi(argv[3]); // 0 to 25000
+        int16_t offset = argc > 4 ? atoi(argv[4]) : 0; // -25000 to 25000
+        configureStream(channel, amplitude, offset);
+    }
+
+    // wavegen play FILE (raw little-endian int16 frames A, B; - for stdin)
+    else if (argc == 3 && strcmp(argv[1], "play") == 0)
+    {
+        FILE *in = strcmp(argv[2], "-") == 0 ? stdin : fopen(argv[2], "rb");
+        if (in == NULL)
+            printf("Could not open %s\n", argv[2]);
+        else if (!streamOpen())
+            printf("Could not map the stream ring, is wavegen_driver loaded with streaming?\n");
+        else
+        {
+            streamStatus status;
+            bool started = false;
+            bool eof = false;
+            bool bOK = true;
+
+            // Read straight into the ring, start once it is full
+            while (!eof && bOK)
+            {
+                uint32_t *frames;
+                uint32_t space = streamAcquire(&frames);
+                if (space == 0)
+                {
+                    if (!started)
+                    {
+                        bOK = streamStart();
+                        started = true;
+                    }
+                    usleep(1000);
+                    continue;
+                }
+                size_t n = fread(frames, sizeof(uint32_t), space, in);
+                streamCommit(n);
+                eof = n < space && (feof(in) || ferror(in));
+            }
+            if (!started)
+                bOK = streamStart();
+            if (bOK)
+                streamDrain();
+            streamGetStatus(&status);
+            streamStop();
+
+            if (!bOK)
+                printf("Could not start the stream\n");
+            else
+                printf("%u underruns, %u starved polls, %u DMA errors\n",
+                    status.underruns, status.starved, status.dmaErrors);
+        }
+        if (in != NULL && in != stdin)
+            fclose(in);
+    }
+
+    // wavegen save FILE / wavegen load FILE (configuration snapshot)
+    else if (argc == 3 && strcmp(argv[1], "save") == 0)
+    {
+        if (!snapshotSave(argv[2]))
+            printf("Could not write %s\n", argv[2]);
+    }
+    else if (argc == 3 && strcmp(argv[1], "load") == 0)
+    {
+        if (!snapshotLoad(argv[2]))
+            printf("Could not load %s, is it a wavegen snapshot?\n", argv[2]);
+    }
+
+    // wavegen preset [save] SLOT
+    else if ((argc == 3 || argc == 4) && strcmp(argv[1], "preset") == 0)
+    {
+        bool save = argc == 4 && strcmp(argv[2], "save") == 0;
+        int slot = atoi(argv[argc - 1]);
+        if (argc == 4 && !save)
+            printf("  command not understood\n");
+        else if (!(save ? presetSave(slot) : presetRecall(slot)))
+            printf("Preset slot must be 0 to 6\n");
+    }
+
+    //wavegen idle OUT LEVEL
+    else if (argc == 4 && strcmp(argv[1], "idle") == 0)
+    {
+        int16_t level = atoi(argv[3]); // -25000 to 25000
+        setIdleLevel(channel, level);
+    }
+    // wavegen noise OUT AMP [OFFS] [white|pink|band] [SEED]
+    else if (argc >= 4 && argc <= 7 && strcmp(argv[1], "noise") == 0)
+    {
+        uint16_t amplitude = atoi(argv[3]); // 0 to 25000
+        int16_t offset = argc > 4 ? atoi(argv[4]) : 0; // -25000 to 25000
+        int shape = NOISE_WHITE;
+        uint32_t seed = argc > 6 ? strtoul(argv[6], NULL, 0) : 0;
+
+        if (argc > 5 && strcmp(argv[5], "pink") == 0)
+            shape = NOISE_PINK;
+        else if (argc > 5 && strcmp(argv[5], "band") == 0)
+            shape = NOISE_BAND;
+
+        configureNoise(channel, amplitude, offset, shape, seed);
+    }
+
     // wavegen {sine|sawtooth|square|triangle} OUT FREQ AMP [OFFS] [PHASE_OFFS] [DTCYC] 
     else if (argc == 5 || argc == 6 || argc == 7 || argc == 8) {
 
@@ -26,10 +26,29 @@
 #include <linux/kobject.h>  // kobject, kobject_atribute,
 #include <linux/module.h>   // MODULE_ macros
                             // kobject_create_and_add, kobject_put
+#include <linux/atomic.h>   // atomic64_t
+#include <linux/debugfs.h>  // debugfs_create_dir, debugfs_create_file
+#include <linux/delay.h>    // udelay
+#include <linux/dma-mapping.h> // dma_alloc_coherent, dma_mmap_coherent
+#include <linux/hrtimer.h>  // hrtimer
+#include <linux/ktime.h>    // ktime_get_ns
+#include <linux/fs.h>       // file_operations
+#include <linux/log2.h>     // ilog2
+#include <linux/math64.h>   // div_u64
+#include <linux/miscdevice.h> // misc_register
+#include <linux/mm.h>       // vm_iomap_memory
+#include <linux/mutex.h>    // DEFINE_MUTEX
+#include <linux/platform_device.h> // platform_device_register_simple
+#include <linux/seq_file.h> // seq_printf, single_open
+#include <linux/slab.h>     // kzalloc, kfree
+#include <linux/sysfs.h>    // bin_attribute
 #include "../address_map.h" // overall memory map
 #include "wavegen_regs.h"   // register offsets in QE IP
 #include <asm/io.h>         // iowrite, ioread, ioremap_nocache (platform specific)
 
+#define CREATE_TRACE_POINTS
+#include "wavegen_trace.h"  // tracepoints
+
 //-----------------------------------------------------------------------------
 // Kernel module information
 //-----------------------------------------------------------------------------
@@ -48,62 +67,170 @@ MODULE_DESCRIPTION("Wavegen IP Driver");
 #define MODE_TRIANGLE   3
 #define MODE_SQUARE     4
 #define MODE_ARB        5
+#define MODE_NOISE      6
+#define MODE_STREAM     7
+
+#define NOISE_WHITE     0
+#define NOISE_PINK      1
+#define NOISE_BAND      2
+
+#define SYNC_OFF        0
+#define SYNC_MASTER     1
+#define SYNC_SLAVE      2
+
+#define TRIGGER_SOFTWARE 0
+#define TRIGGER_PIN      1
+#define TRIGGER_SYNC     2
 
 static uint32_t *base = NULL;
 
+// Latency statistics, per operation, with log2 histograms in ns
+// (bucket i counts latencies from 2^i to 2^(i+1)-1 ns, the last one the rest)
+#define STAT_BUCKETS 24
+
+enum
+{
+    STAT_REG_READ,
+    STAT_REG_WRITE,
+    STAT_SYSFS_SHOW,
+    STAT_SYSFS_STORE,
+    STAT_COUNT
+};
+
+static const char *stat_names[] = {
+    [STAT_REG_READ] = "ioread32",
+    [STAT_REG_WRITE] = "iowrite32",
+    [STAT_SYSFS_SHOW] = "sysfs show",
+    [STAT_SYSFS_STORE] = "sysfs store"
+};
+
+struct opStats
+{
+    atomic64_t count;
+    atomic64_t totalNs;
+    atomic64_t maxNs;
+    atomic64_t buckets[STAT_BUCKETS];
+};
+
+static struct opStats stats[STAT_COUNT];
+
+static bool collectStats = true;
+module_param(collectStats, bool, 0644);
+MODULE_PARM_DESC(collectStats, "Time register and sysfs accesses for debugfs wavegen/stats");
+
+static struct dentry *debugDir;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
+// Statistics
+static void recordLatency(int op, u64 ns)
+{
+    struct opStats *stat = &stats[op];
+    int bucket = ns > 1 ? min_t(int, ilog2(ns), STAT_BUCKETS - 1) : 0;
+    s64 max = atomic64_read(&stat->maxNs);
+
+    atomic64_inc(&stat->count);
+    atomic64_add(ns, &stat->totalNs);
+    atomic64_inc(&stat->buckets[bucket]);
+    while (ns > max)
+    {
+        s64 prev = atomic64_cmpxchg(&stat->maxNs, max, ns);
+        if (prev == max)
+            break;
+        max = prev;
+    }
+}
+
+static void clearStats(void)
+{
+    int op, i;
+    for (op = 0; op < STAT_COUNT; op++)
+    {
+        atomic64_set(&stats[op].count, 0);
+        atomic64_set(&stats[op].totalNs, 0);
+        atomic64_set(&stats[op].maxNs, 0);
+        for (i = 0; i < STAT_BUCKETS; i++)
+            atomic64_set(&stats[op].buckets[i], 0);
+    }
+}
+
+// Register access, every ioread32/iowrite32 of the IP goes through these
+static uint32_t readReg(unsigned int offset)
+{
+    u64 start = collectStats ? ktime_get_ns() : 0;
+    uint32_t val = ioread32(base + offset);
+    u64 ns = collectStats ? ktime_get_ns() - start : 0;
+
+    if (collectStats)
+        recordLatency(STAT_REG_READ, ns);
+    trace_wavegen_reg_read(offset, val, ns);
+    return val;
+}
+
+static void writeReg(uint32_t val, unsigned int offset)
+{
+    u64 start = collectStats ? ktime_get_ns() : 0;
+    u64 ns;
+
+    iowrite32(val, base + offset);
+    ns = collectStats ? ktime_get_ns() - start : 0;
+
+    if (collectStats)
+        recordLatency(STAT_REG_WRITE, ns);
+    trace_wavegen_reg_write(offset, val, ns);
+}
+
 // Mode
 void setMode(uint8_t channel, uint8_t mode)
 {
-    uint32_t val = ioread32(base + OFS_MODE) & ~(MMODE_MASK << channel*3);
+    uint32_t val = readReg(OFS_MODE) & ~(MMODE_MASK << channel*3);
     val |= (mode << channel*3);
 
-    iowrite32(val, base + OFS_MODE);
+    writeReg(val, OFS_MODE);
 }
 
 uint8_t getMode(uint8_t channel)
 {
-    return (ioread32(base + OFS_MODE) >> channel*3) ;
+    return (readReg(OFS_MODE) >> channel*3) ;
 }
 
 // Run
 void setRunning(uint8_t channel, bool running)
 {
-    uint32_t val = ioread32(base + OFS_RUN);
+    uint32_t val = readReg(OFS_RUN);
     uint8_t a = channel == 0 ? (val & RUN_A) : running;
     uint8_t b = channel == 1 ? (val & RUN_B) : running << 1;
 
-    iowrite32(a | b, base + OFS_RUN);
+    writeReg(a | b, OFS_RUN);
 }
 
 bool isChannelRunning(uint8_t channel)
 {
-    return (ioread32(base + OFS_RUN) >> channel) & RUN_MASK;
+    return (readReg(OFS_RUN) >> channel) & RUN_MASK;
 }
 
 // Freq A
 void setfreqA(uint32_t freqA)
 {
-    iowrite32(freqA, base + OFS_FREQ_A);
+    writeReg(freqA, OFS_FREQ_A);
 }
 
 int32_t getfreqA(void)
 {
-    return ioread32(base + OFS_FREQ_A);
+    return readReg(OFS_FREQ_A);
 }
 
 // Freq B
 void setfreqB(uint32_t freqB)
 {
-    iowrite32(freqB, base + OFS_FREQ_B);
+    writeReg(freqB, OFS_FREQ_B);
 }
 
 int32_t getfreqB(void)
 {
-    return ioread32(base + OFS_FREQ_B);
+    return readReg(OFS_FREQ_B);
 }
 
 // Offset A
@@ -111,75 +238,216 @@ void setOffsetA(uint8_t channel, int32_t offsetA)
 {
     int shift = channel ? 16 : 0;
 
-    uint32_t val = ioread32(base + OFS_OFFSET) & ~(OFFSET_MASK << shift);
+    uint32_t val = readReg(OFS_OFFSET) & ~(OFFSET_MASK << shift);
     val |= (offsetA << shift);
 
-    printk(KERN_INFO "Writing %d to %p (offset)", val, base + OFS_OFFSET);
-    iowrite32(val, base + OFS_OFFSET);
+    writeReg(val, OFS_OFFSET);
 }
 
 uint16_t getOffsetA(uint8_t channel)
 {
-    return (ioread32(base + OFS_OFFSET) >> channel*16);
+    return (readReg(OFS_OFFSET) >> channel*16);
 }
 
 // Amplitude A
 void setAmplitude(uint8_t channel, uint32_t amplitude)
 {
     int shift = channel ? 16 : 0;
-    uint32_t val = ioread32(base + OFS_AMPLITUDE) & ~(AMPLITUDE_MASK << shift);
+    uint32_t val = readReg(OFS_AMPLITUDE) & ~(AMPLITUDE_MASK << shift);
     val |= (amplitude << shift);
 
-    printk(KERN_INFO "Writing %d to %p (amplitude)", val, base + OFS_AMPLITUDE);
-    iowrite32(val, base + OFS_AMPLITUDE);
+    writeReg(val, OFS_AMPLITUDE);
 }
 
 uint16_t getAmplitude(uint8_t channel)
 {
-    return (ioread32(base + OFS_AMPLITUDE) >> channel*16);
+    return (readReg(OFS_AMPLITUDE) >> channel*16);
 }
 
 // Duty Cycle A
 void setDutyCycle(uint8_t channel, uint32_t dutyCycle)
 {
     int shift = channel ? 16 : 0;
-    uint32_t val = ioread32(base + OFS_DTYCYC) & ~(DTYCYC_MASK << shift);
+    uint32_t val = readReg(OFS_DTYCYC) & ~(DTYCYC_MASK << shift);
     val |= (dutyCycle << shift);
-    iowrite32(val, base + OFS_DTYCYC);
+    writeReg(val, OFS_DTYCYC);
 }
 
 uint16_t getDutyCycle(uint8_t channel)
 {
-    return ioread32(base + OFS_DTYCYC) >> channel*16;
+    return readReg(OFS_DTYCYC) >> channel*16;
 }
 
 // Cycle A
-void setCycle(uint8_t channel, uint16_t cycle)
+void setCycle(uint8_t channel, uint32_t cycle)
+{
+    writeReg(cycle, (channel ? OFS_CYCLES_B : OFS_CYCLES_A));
+}
+
+uint32_t getCycle(uint8_t channel)
+{
+    return readReg((channel ? OFS_CYCLES_B : OFS_CYCLES_A));
+}
+
+// Stop Phase A (units of 1/2^16 cycle)
+void setStopPhase(uint8_t channel, uint16_t stopPhase)
+{
+    int shift = channel ? 16 : 0;
+    uint32_t val = readReg(OFS_STOP_PHASE) & ~(0xFFFF << shift);
+    val |= (stopPhase << shift);
+    writeReg(val, OFS_STOP_PHASE);
+}
+
+uint16_t getStopPhase(uint8_t channel)
+{
+    return readReg(OFS_STOP_PHASE) >> channel*16;
+}
+
+// Idle Level A
+void setIdleLevel(uint8_t channel, int16_t level)
 {
     int shift = channel ? 16 : 0;
-    uint32_t val = ioread32(base + OFS_CYCLES) & ~(DTYCYC_MASK << shift);
-    val |= (cycle << shift);
-    iowrite32(val, base + OFS_CYCLES);
+    uint32_t val = readReg(OFS_IDLE) & ~(0xFFFF << shift);
+    val |= ((uint16_t)level << shift);
+    writeReg(val, OFS_IDLE);
 }
 
-uint16_t getCycle(uint8_t channel)
+int16_t getIdleLevel(uint8_t channel)
 {
-    return ioread32(base + OFS_CYCLES) >> channel*16;
+    return readReg(OFS_IDLE) >> channel*16;
 }
 
 // Phase Offset A
 void setPhaseOffset(uint8_t channel, int16_t phaseOffset)
 {
     int shift = channel ? 16 : 0;
-    uint32_t val = ioread32(base + OFS_PHASE_OFFS) & ~(DTYCYC_MASK << shift);
+    uint32_t val = readReg(OFS_PHASE_OFFS) & ~(DTYCYC_MASK << shift);
     val |= (phaseOffset << shift);
 
-    iowrite32(val, base + OFS_PHASE_OFFS);
+    writeReg(val, OFS_PHASE_OFFS);
 }
 
 int16_t getPhaseOffset(uint8_t channel)
 {
-    return (ioread32(base + OFS_PHASE_OFFS) >> channel*16);
+    return (readReg(OFS_PHASE_OFFS) >> channel*16);
+}
+
+// Noise
+void setNoiseShape(uint8_t channel, uint8_t shape)
+{
+    int shift = channel ? 16 : 0;
+    uint32_t val = readReg(OFS_NOISE) & ~(NOISE_SHAPE_MASK << shift);
+    val |= ((shape & NOISE_SHAPE_MASK) << shift);
+    writeReg(val, OFS_NOISE);
+}
+
+uint8_t getNoiseShape(uint8_t channel)
+{
+    return (readReg(OFS_NOISE) >> channel*16) & NOISE_SHAPE_MASK;
+}
+
+void setNoiseSeed(uint8_t channel, uint32_t seed)
+{
+    writeReg(seed, (channel ? OFS_NOISE_SEED_B : OFS_NOISE_SEED_A));
+}
+
+uint32_t getNoiseSeed(uint8_t channel)
+{
+    return readReg((channel ? OFS_NOISE_SEED_B : OFS_NOISE_SEED_A));
+}
+
+// Sync
+void setSyncMode(uint8_t mode)
+{
+    writeReg(mode & SYNC_MODE_MASK, OFS_SYNC);
+}
+
+uint8_t getSyncMode(void)
+{
+    return readReg(OFS_SYNC) & SYNC_MODE_MASK;
+}
+
+void syncArm(void)
+{
+    uint32_t val = readReg(OFS_SYNC) & SYNC_MODE_MASK;
+    writeReg(val | SYNC_ARM, OFS_SYNC);
+}
+
+bool isSyncArmed(void)
+{
+    return (readReg(OFS_SYNC) & SYNC_ARM) != 0;
+}
+
+// Trigger
+void setTriggerArm(uint8_t channel, bool armed)
+{
+    uint32_t val = readReg(OFS_TRIG) & ~TRIG_FIRE & ~(1 << channel);
+    val |= (armed << channel);
+    writeReg(val, OFS_TRIG);
+}
+
+bool isTriggerArmed(uint8_t channel)
+{
+    return (readReg(OFS_TRIG) >> channel) & 1;
+}
+
+void setTriggerSource(uint8_t source)
+{
+    uint32_t val = readReg(OFS_TRIG) & ~TRIG_FIRE & ~(TRIG_SRC_MASK << TRIG_SRC_SHIFT);
+    val |= (source & TRIG_SRC_MASK) << TRIG_SRC_SHIFT;
+    writeReg(val, OFS_TRIG);
+}
+
+uint8_t getTriggerSource(void)
+{
+    return (readReg(OFS_TRIG) >> TRIG_SRC_SHIFT) & TRIG_SRC_MASK;
+}
+
+void setTriggerFalling(bool falling)
+{
+    uint32_t val = readReg(OFS_TRIG) & ~TRIG_FIRE & ~TRIG_FALLING;
+    writeReg(val | (falling ? TRIG_FALLING : 0), OFS_TRIG);
+}
+
+bool isTriggerFalling(void)
+{
+    return (readReg(OFS_TRIG) & TRIG_FALLING) != 0;
+}
+
+void fireTrigger(void)
+{
+    writeReg(readReg(OFS_TRIG) | TRIG_FIRE, OFS_TRIG);
+}
+
+void setHoldoff(uint32_t holdoff)
+{
+    writeReg(holdoff, OFS_HOLDOFF);
+}
+
+uint32_t getHoldoff(void)
+{
+    return readReg(OFS_HOLDOFF);
+}
+
+// Last slot recalled, through the library or sysfs
+uint32_t getPreset(void)
+{
+    return (readReg(OFS_PRESET) >> PRESET_RECALLED_SHIFT) & PRESET_SLOT_MASK;
+}
+
+uint32_t getTriggerCount(void)
+{
+    return readReg(OFS_TRIG_COUNT);
+}
+
+uint32_t getTriggerMissed(void)
+{
+    return readReg(OFS_TRIG_MISSED);
+}
+
+void clearTriggerCounts(void)
+{
+    writeReg(0, OFS_TRIG_COUNT);
 }
 
 
@@ -192,12 +460,43 @@ const char *mode_map[] = {
     [MODE_SINE] = "sine",
     [MODE_SAWTOOTH] = "sawtooth",
     [MODE_TRIANGLE] = "triangle",
-    [MODE_SQUARE] = "triangle",
-    [MODE_ARB] = "arb"
+    [MODE_SQUARE] = "square",
+    [MODE_ARB] = "arb",
+    [MODE_NOISE] = "noise",
+    [MODE_STREAM] = "stream"
 };
 
 #define MAP_SIZE (sizeof(mode_map)/sizeof(mode_map[0]))
 
+// Noise shape
+const char *noise_map[] = {
+    [NOISE_WHITE] = "white",
+    [NOISE_PINK] = "pink",
+    [NOISE_BAND] = "band"
+};
+
+#define NOISE_MAP_SIZE (sizeof(noise_map)/sizeof(noise_map[0]))
+
+static ssize_t noiseShapeStore(uint8_t channel, const char *buffer, size_t count)
+{
+    int i = 0;
+    for (; i < NOISE_MAP_SIZE; ++i)
+    {
+        if (strncmp(buffer, noise_map[i], strlen(noise_map[i])) == 0)
+        {
+            setNoiseShape(channel, i);
+            break;
+        }
+    }
+    return count;
+}
+
+static ssize_t noiseShapeShow(uint8_t channel, char *buffer)
+{
+    uint8_t shape = getNoiseShape(channel);
+    return sprintf(buffer, "%s\n", shape < NOISE_MAP_SIZE ? noise_map[shape] : "unknown");
+}
+
 // Mode
 static uint32_t modeA = 0;
 module_param(modeA, uint, S_IRUGO);
@@ -357,6 +656,48 @@ static ssize_t cycleAShow(struct kobject *kobj, struct kobj_attribute *attr, cha
 
 static struct kobj_attribute cycleAAttr = __ATTR(cycleA, 0664, cycleAShow, cycleAStore);
 
+// Stop Phase
+static uint32_t stopPhaseA = 0;
+module_param(stopPhaseA, uint, S_IRUGO);
+MODULE_PARM_DESC(stopPhaseA, "Burst stop phase setting");
+
+static ssize_t stopPhaseAStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtouint(buffer, 0, &stopPhaseA);
+    if (result == 0 && stopPhaseA < 360)
+        setStopPhase(0, (stopPhaseA << 16)/360);
+    return count;
+}
+
+static ssize_t stopPhaseAShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    stopPhaseA = getStopPhase(0);
+    return sprintf(buffer, "%u degrees\n", (stopPhaseA*360) >> 16);
+}
+
+static struct kobj_attribute stopPhaseAAttr = __ATTR(stopPhaseA, 0664, stopPhaseAShow, stopPhaseAStore);
+
+// Idle Level
+static int32_t idleA = 0;
+module_param(idleA, int, S_IRUGO);
+MODULE_PARM_DESC(idleA, "Idle level setting");
+
+static ssize_t idleAStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtoint(buffer, 0, &idleA);
+    if (result == 0)
+        setIdleLevel(0, idleA);
+    return count;
+}
+
+static ssize_t idleAShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    idleA = getIdleLevel(0);
+    return sprintf(buffer, "%d\n", idleA);
+}
+
+static struct kobj_attribute idleAAttr = __ATTR(idleA, 0664, idleAShow, idleAStore);
+
 // Phase Offset
 static uint32_t phaseOffsetA = 0;
 module_param(phaseOffsetA, uint, S_IRUGO);
@@ -378,6 +719,56 @@ static ssize_t phaseOffsetAShow(struct kobject *kobj, struct kobj_attribute *att
 
 static struct kobj_attribute phaseOffsetAAttr = __ATTR(phaseOffsetA, 0664, phaseOffsetAShow, phaseOffsetAStore);
 
+// Trigger arm
+static ssize_t triggerAStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    bool armed;
+    int result = kstrtobool(buffer, &armed);
+    if (result == 0)
+        setTriggerArm(0, armed);
+    return count;
+}
+
+static ssize_t triggerAShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return sprintf(buffer, "%d\n", isTriggerArmed(0));
+}
+
+static struct kobj_attribute triggerAAttr = __ATTR(triggerA, 0664, triggerAShow, triggerAStore);
+
+// Noise
+static ssize_t noiseShapeAStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    return noiseShapeStore(0, buffer, count);
+}
+
+static ssize_t noiseShapeAShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return noiseShapeShow(0, buffer);
+}
+
+static struct kobj_attribute noiseShapeAAttr = __ATTR(noiseShapeA, 0664, noiseShapeAShow, noiseShapeAStore);
+
+static uint32_t noiseSeedA = 0;
+module_param(noiseSeedA, uint, S_IRUGO);
+MODULE_PARM_DESC(noiseSeedA, "Noise seed setting");
+
+static ssize_t noiseSeedAStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtouint(buffer, 0, &noiseSeedA);
+    if (result == 0)
+        setNoiseSeed(0, noiseSeedA);
+    return count;
+}
+
+static ssize_t noiseSeedAShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    noiseSeedA = getNoiseSeed(0);
+    return sprintf(buffer, "0x%08x\n", noiseSeedA);
+}
+
+static struct kobj_attribute noiseSeedAAttr = __ATTR(noiseSeedA, 0664, noiseSeedAShow, noiseSeedAStore);
+
 // Mode
 static uint32_t modeB = 0;
 module_param(modeB, uint, S_IRUGO);
@@ -514,6 +905,48 @@ static ssize_t cycleBShow(struct kobject *kobj, struct kobj_attribute *attr, cha
 
 static struct kobj_attribute cycleBAttr = __ATTR(cycleB, 0664, cycleBShow, cycleBStore);
 
+// Stop Phase
+static uint32_t stopPhaseB = 0;
+module_param(stopPhaseB, uint, S_IRUGO);
+MODULE_PARM_DESC(stopPhaseB, "Burst stop phase setting");
+
+static ssize_t stopPhaseBStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtouint(buffer, 0, &stopPhaseB);
+    if (result == 0 && stopPhaseB < 360)
+        setStopPhase(1, (stopPhaseB << 16)/360);
+    return count;
+}
+
+static ssize_t stopPhaseBShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    stopPhaseB = getStopPhase(1);
+    return sprintf(buffer, "%u degrees\n", (stopPhaseB*360) >> 16);
+}
+
+static struct kobj_attribute stopPhaseBAttr = __ATTR(stopPhaseB, 0664, stopPhaseBShow, stopPhaseBStore);
+
+// Idle Level
+static int32_t idleB = 0;
+module_param(idleB, int, S_IRUGO);
+MODULE_PARM_DESC(idleB, "Idle level setting");
+
+static ssize_t idleBStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtoint(buffer, 0, &idleB);
+    if (result == 0)
+        setIdleLevel(1, idleB);
+    return count;
+}
+
+static ssize_t idleBShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    idleB = getIdleLevel(1);
+    return sprintf(buffer, "%d\n", idleB);
+}
+
+static struct kobj_attribute idleBAttr = __ATTR(idleB, 0664, idleBShow, idleBStore);
+
 // Phase Offset
 static uint32_t phaseOffsetB = 0;
 module_param(phaseOffsetB, uint, S_IRUGO);
@@ -535,11 +968,374 @@ static ssize_t phaseOffsetBShow(struct kobject *kobj, struct kobj_attribute *att
 
 static struct kobj_attribute phaseOffsetBAttr = __ATTR(phaseOffsetB, 0664, phaseOffsetBShow, phaseOffsetBStore);
 
+// Trigger arm
+static ssize_t triggerBStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    bool armed;
+    int result = kstrtobool(buffer, &armed);
+    if (result == 0)
+        setTriggerArm(1, armed);
+    return count;
+}
+
+static ssize_t triggerBShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return sprintf(buffer, "%d\n", isTriggerArmed(1));
+}
+
+static struct kobj_attribute triggerBAttr = __ATTR(triggerB, 0664, triggerBShow, triggerBStore);
+
+// Noise
+static ssize_t noiseShapeBStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    return noiseShapeStore(1, buffer, count);
+}
+
+static ssize_t noiseShapeBShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return noiseShapeShow(1, buffer);
+}
+
+static struct kobj_attribute noiseShapeBAttr = __ATTR(noiseShapeB, 0664, noiseShapeBShow, noiseShapeBStore);
+
+static uint32_t noiseSeedB = 0;
+module_param(noiseSeedB, uint, S_IRUGO);
+MODULE_PARM_DESC(noiseSeedB, "Noise seed setting");
+
+static ssize_t noiseSeedBStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtouint(buffer, 0, &noiseSeedB);
+    if (result == 0)
+        setNoiseSeed(1, noiseSeedB);
+    return count;
+}
+
+static ssize_t noiseSeedBShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    noiseSeedB = getNoiseSeed(1);
+    return sprintf(buffer, "0x%08x\n", noiseSeedB);
+}
+
+static struct kobj_attribute noiseSeedBAttr = __ATTR(noiseSeedB, 0664, noiseSeedBShow, noiseSeedBStore);
+
+// Sync
+const char *sync_map[] = {
+    [SYNC_OFF] = "off",
+    [SYNC_MASTER] = "master",
+    [SYNC_SLAVE] = "slave"
+};
+
+#define SYNC_MAP_SIZE (sizeof(sync_map)/sizeof(sync_map[0]))
+
+static ssize_t syncStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int i = 0;
+    for (; i < SYNC_MAP_SIZE; ++i)
+    {
+        if (strncmp(buffer, sync_map[i], strlen(sync_map[i])) == 0)
+        {
+            setSyncMode(i);
+            break;
+        }
+    }
+    return count;
+}
+
+static ssize_t syncShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    uint8_t mode = getSyncMode();
+    return sprintf(buffer, "%s\n", mode < SYNC_MAP_SIZE ? sync_map[mode] : "unknown");
+}
+
+static struct kobj_attribute syncAttr = __ATTR(sync, 0664, syncShow, syncStore);
+
+// Arm (write anything to arm, reads 1 while waiting for the sync edge)
+static ssize_t armStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    syncArm();
+    return count;
+}
+
+static ssize_t armShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return sprintf(buffer, "%d\n", isSyncArmed());
+}
+
+static struct kobj_attribute armAttr = __ATTR(arm, 0664, armShow, armStore);
+
+// Trigger source
+const char *trigger_map[] = {
+    [TRIGGER_SOFTWARE] = "soft",
+    [TRIGGER_PIN] = "pin",
+    [TRIGGER_SYNC] = "sync"
+};
+
+#define TRIGGER_MAP_SIZE (sizeof(trigger_map)/sizeof(trigger_map[0]))
+
+static ssize_t triggerSourceStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int i = 0;
+    for (; i < TRIGGER_MAP_SIZE; ++i)
+    {
+        if (strncmp(buffer, trigger_map[i], strlen(trigger_map[i])) == 0)
+        {
+            setTriggerSource(i);
+            break;
+        }
+    }
+    return count;
+}
+
+static ssize_t triggerSourceShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    uint8_t source = getTriggerSource();
+    return sprintf(buffer, "%s\n", source < TRIGGER_MAP_SIZE ? trigger_map[source] : "unknown");
+}
+
+static struct kobj_attribute triggerSourceAttr = __ATTR(triggerSource, 0664, triggerSourceShow, triggerSourceStore);
+
+// Trigger edge
+static ssize_t triggerEdgeStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    if (strncmp(buffer, "rising", 6) == 0)
+        setTriggerFalling(false);
+    else if (strncmp(buffer, "falling", 7) == 0)
+        setTriggerFalling(true);
+    return count;
+}
+
+static ssize_t triggerEdgeShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return sprintf(buffer, "%s\n", isTriggerFalling() ? "falling" : "rising");
+}
+
+static struct kobj_attribute triggerEdgeAttr = __ATTR(triggerEdge, 0664, triggerEdgeShow, triggerEdgeStore);
+
+// Holdoff
+static uint32_t holdoff = 0;
+module_param(holdoff, uint, S_IRUGO);
+MODULE_PARM_DESC(holdoff, "Trigger holdoff in samples");
+
+static ssize_t holdoffStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    int result = kstrtouint(buffer, 0, &holdoff);
+    if (result == 0)
+        setHoldoff(holdoff);
+    return count;
+}
+
+static ssize_t holdoffShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    holdoff = getHoldoff();
+    return sprintf(buffer, "%u\n", holdoff);
+}
+
+static struct kobj_attribute holdoffAttr = __ATTR(holdoff, 0664, holdoffShow, holdoffStore);
+
+// Trigger (write anything to fire a software trigger)
+static ssize_t triggerStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    fireTrigger();
+    return count;
+}
+
+static struct kobj_attribute triggerAttr = __ATTR(trigger, 0220, NULL, triggerStore);
+
+// Trigger counts (write anything to clear both)
+static ssize_t triggerCountStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    clearTriggerCounts();
+    return count;
+}
+
+static ssize_t triggerCountShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return sprintf(buffer, "%u\n", getTriggerCount());
+}
+
+static struct kobj_attribute triggerCountAttr = __ATTR(triggerCount, 0664, triggerCountShow, triggerCountStore);
+
+static ssize_t triggerMissedShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    return sprintf(buffer, "%u\n", getTriggerMissed());
+}
+
+static struct kobj_attribute triggerMissedAttr = __ATTR(triggerMissed, 0444, triggerMissedShow, NULL);
+
+// Presets and snapshots
+// The preset port (slot and word index) is shared, so accesses through it
+// are serialized
+static DEFINE_MUTEX(presetLock);
+static const unsigned int presetRegs[PRESET_WORDS] = PRESET_REGS;
+
+// Waits for a recall, which the IP applies at the next sample clock
+static int presetWait(void)
+{
+    int timeout = 1000;
+    while ((readReg(OFS_PRESET) & PRESET_PENDING) && --timeout)
+        udelay(1);
+    return timeout ? 0 : -ETIMEDOUT;
+}
+
+static void snapshotCapture(struct wavegenSnapshot *snapshot)
+{
+    int slot, i;
+
+    memset(snapshot, 0, sizeof(*snapshot));
+    snapshot->magic = SNAPSHOT_MAGIC;
+    snapshot->version = SNAPSHOT_VERSION;
+    snapshot->size = sizeof(*snapshot);
+    for (i = 0; i < PRESET_WORDS; i++)
+        snapshot->channels[i] = readReg(presetRegs[i]);
+    snapshot->sync = readReg(OFS_SYNC) & SYNC_MODE_MASK;
+    snapshot->trigger = readReg(OFS_TRIG) & (TRIG_ARM_MASK | (TRIG_SRC_MASK << TRIG_SRC_SHIFT) | TRIG_FALLING);
+    snapshot->holdoff = readReg(OFS_HOLDOFF);
+
+    for (slot = 0; slot < PRESET_STAGING; slot++)
+        for (i = 0; i < PRESET_WORDS; i++)
+        {
+            writeReg(slot | (i << PRESET_INDEX_SHIFT), OFS_PRESET);
+            snapshot->presets[slot][i] = readReg(OFS_PRESET_DATA);
+        }
+}
+
+// Loads the presets, stages the channel settings in the staging slot and
+// recalls it, so the outputs change in one step, then restores the trigger
+// and sync settings
+static int snapshotRestore(const struct wavegenSnapshot *snapshot)
+{
+    int slot, i, result;
+
+    if (snapshot->magic != SNAPSHOT_MAGIC || snapshot->version < SNAPSHOT_VERSION
+        || snapshot->size < sizeof(*snapshot))
+        return -EINVAL;
+
+    for (slot = 0; slot < PRESET_STAGING; slot++)
+    {
+        writeReg(slot, OFS_PRESET);
+        for (i = 0; i < PRESET_WORDS; i++)
+            writeReg(snapshot->presets[slot][i], OFS_PRESET_DATA);
+    }
+    writeReg(PRESET_STAGING, OFS_PRESET);
+    for (i = 0; i < PRESET_WORDS; i++)
+        writeReg(snapshot->channels[i], OFS_PRESET_DATA);
+
+    writeReg(PRESET_STAGING | PRESET_RECALL, OFS_PRESET);
+    result = presetWait();
+    if (result)
+        return result;
+
+    // Trigger and sync settings (arm bits included) only after the recall,
+    // so an arm can never fire on the old channel settings
+    writeReg(snapshot->holdoff, OFS_HOLDOFF);
+    writeReg(snapshot->sync & SYNC_MODE_MASK, OFS_SYNC);
+    writeReg(snapshot->trigger & ~TRIG_FIRE, OFS_TRIG);
+    return 0;
+}
+
+// Snapshot (binary, read to capture, write a whole snapshot to restore)
+static ssize_t snapshotRead(struct file *file, struct kobject *kobj, struct bin_attribute *attr,
+                            char *buffer, loff_t offset, size_t count)
+{
+    struct wavegenSnapshot snapshot;
+    u64 start = ktime_get_ns();
+
+    trace_wavegen_entry(attr->attr.name, "read");
+    if (offset >= sizeof(snapshot))
+        count = 0;
+    else
+    {
+        mutex_lock(&presetLock);
+        snapshotCapture(&snapshot);
+        mutex_unlock(&presetLock);
+        count = min_t(size_t, count, sizeof(snapshot) - offset);
+        memcpy(buffer, (char *)&snapshot + offset, count);
+    }
+    trace_wavegen_return(attr->attr.name, "read", count, ktime_get_ns() - start);
+    return count;
+}
+
+static ssize_t snapshotWrite(struct file *file, struct kobject *kobj, struct bin_attribute *attr,
+                             char *buffer, loff_t offset, size_t count)
+{
+    struct wavegenSnapshot snapshot;
+    u64 start = ktime_get_ns();
+    ssize_t result;
+
+    trace_wavegen_entry(attr->attr.name, "write");
+    if (offset != 0 || count < sizeof(snapshot))
+        result = -EINVAL;
+    else
+    {
+        memcpy(&snapshot, buffer, sizeof(snapshot));
+        mutex_lock(&presetLock);
+        result = snapshotRestore(&snapshot);
+        mutex_unlock(&presetLock);
+        if (result == 0)
+            result = count;
+    }
+    trace_wavegen_return(attr->attr.name, "write", result, ktime_get_ns() - start);
+    return result;
+}
+
+static struct bin_attribute snapshotAttr = __BIN_ATTR(snapshot, 0664, snapshotRead, snapshotWrite, sizeof(struct wavegenSnapshot));
+
+// Preset (write a slot number to recall it, reads the last slot recalled by
+// any path, the staging slot after a snapshot restore)
+static uint32_t preset = 0;
+module_param(preset, uint, S_IRUGO);
+MODULE_PARM_DESC(preset, "Preset slot");
+
+static ssize_t presetStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    unsigned int slot;
+    int result = kstrtouint(buffer, 0, &slot);
+    if (result == 0 && slot < PRESET_STAGING)
+    {
+        mutex_lock(&presetLock);
+        writeReg(slot | PRESET_RECALL, OFS_PRESET);
+        mutex_unlock(&presetLock);
+    }
+    return count;
+}
+
+static ssize_t presetShow(struct kobject *kobj, struct kobj_attribute *attr, char *buffer)
+{
+    preset = getPreset();
+    return sprintf(buffer, "%u\n", preset);
+}
+
+static struct kobj_attribute presetAttr = __ATTR(preset, 0664, presetShow, presetStore);
+
+// Preset save (write a slot number to copy the channel settings to it)
+static ssize_t presetSaveStore(struct kobject *kobj, struct kobj_attribute *attr, const char *buffer, size_t count)
+{
+    unsigned int slot;
+    int result = kstrtouint(buffer, 0, &slot);
+    if (result == 0 && slot < PRESET_STAGING)
+    {
+        mutex_lock(&presetLock);
+        writeReg(slot | PRESET_SAVE, OFS_PRESET);
+        mutex_unlock(&presetLock);
+    }
+    return count;
+}
+
+static struct kobj_attribute presetSaveAttr = __ATTR(presetSave, 0220, NULL, presetSaveStore);
+
 // Attributes
-static struct attribute *wavegenAAttrs[] = {&modeAAttr.attr, &Attr.attr, &freqAAttr.attr, &offsetAAttr.attr, &amplitudeAAttr.attr, &dutyCycleAAttr.attr, &cycleAAttr.attr, &phaseOffsetAAttr.attr, NULL};
-static struct attribute *wavegenBAttrs[] = {&modeBAttr.attr, &Attr.attr, &freqBAttr.attr, &offsetBAttr.attr, &amplitudeBAttr.attr, &dutyCycleBAttr.attr, &cycleBAttr.attr, &phaseOffsetBAttr.attr, NULL};
+static struct attribute *wavegenAttrs[] = {&syncAttr.attr, &armAttr.attr, &triggerSourceAttr.attr, &triggerEdgeAttr.attr, &holdoffAttr.attr, &triggerAttr.attr, &triggerCountAttr.attr, &triggerMissedAttr.attr, &presetAttr.attr, &presetSaveAttr.attr, NULL};
+static struct bin_attribute *wavegenBinAttrs[] = {&snapshotAttr, NULL};
+static struct attribute *wavegenAAttrs[] = {&modeAAttr.attr, &Attr.attr, &freqAAttr.attr, &offsetAAttr.attr, &amplitudeAAttr.attr, &dutyCycleAAttr.attr, &cycleAAttr.attr, &stopPhaseAAttr.attr, &idleAAttr.attr, &phaseOffsetAAttr.attr, &triggerAAttr.attr, &noiseShapeAAttr.attr, &noiseSeedAAttr.attr, NULL};
+static struct attribute *wavegenBAttrs[] = {&modeBAttr.attr, &Attr.attr, &freqBAttr.attr, &offsetBAttr.attr, &amplitudeBAttr.attr, &dutyCycleBAttr.attr, &cycleBAttr.attr, &stopPhaseBAttr.attr, &idleBAttr.attr, &phaseOffsetBAttr.attr, &triggerBAttr.attr, &noiseShapeBAttr.attr, &noiseSeedBAttr.attr, NULL};
 
 // clang-format off
+static struct attribute_group wavegen =
+{
+    .attrs = wavegenAttrs,
+    .bin_attrs = wavegenBinAttrs
+};
+
 static struct attribute_group channelA =
 {
     .name = "a",
@@ -555,6 +1351,402 @@ static struct attribute_group channelB =
 
 static struct kobject *kobj;
 
+// Every show and store is dispatched through here, so each sysfs entry is
+// traced and timed from entry to return
+static ssize_t wavegenAttrShow(struct kobject *kobj, struct attribute *attr, char *buffer)
+{
+    struct kobj_attribute *kattr = container_of(attr, struct kobj_attribute, attr);
+    u64 start = ktime_get_ns();
+    ssize_t result = -EIO;
+    u64 ns;
+
+    trace_wavegen_entry(attr->name, "show");
+    if (kattr->show)
+        result = kattr->show(kobj, kattr, buffer);
+    ns = ktime_get_ns() - start;
+
+    if (collectStats)
+        recordLatency(STAT_SYSFS_SHOW, ns);
+    trace_wavegen_return(attr->name, "show", result, ns);
+    return result;
+}
+
+static ssize_t wavegenAttrStore(struct kobject *kobj, struct attribute *attr, const char *buffer, size_t count)
+{
+    struct kobj_attribute *kattr = container_of(attr, struct kobj_attribute, attr);
+    u64 start = ktime_get_ns();
+    ssize_t result = -EIO;
+    u64 ns;
+
+    trace_wavegen_entry(attr->name, "store");
+    if (kattr->store)
+        result = kattr->store(kobj, kattr, buffer, count);
+    ns = ktime_get_ns() - start;
+
+    if (collectStats)
+        recordLatency(STAT_SYSFS_STORE, ns);
+    trace_wavegen_return(attr->name, "store", result, ns);
+    return result;
+}
+
+static const struct sysfs_ops wavegenSysfsOps =
+{
+    .show = wavegenAttrShow,
+    .store = wavegenAttrStore
+};
+
+static void wavegenRelease(struct kobject *kobj)
+{
+    kfree(kobj);
+}
+
+static struct kobj_type wavegenKtype =
+{
+    .release = wavegenRelease,
+    .sysfs_ops = &wavegenSysfsOps
+};
+
+//-----------------------------------------------------------------------------
+// Debugfs
+//-----------------------------------------------------------------------------
+
+// wavegen/stats: counts, mean and max latency, and histogram per operation
+// Write anything to clear
+static int statsShow(struct seq_file *file, void *unused)
+{
+    int op, i;
+    for (op = 0; op < STAT_COUNT; op++)
+    {
+        u64 count = atomic64_read(&stats[op].count);
+        u64 total = atomic64_read(&stats[op].totalNs);
+
+        seq_printf(file, "%s: count %llu, mean %llu ns, max %lld ns\n", stat_names[op],
+                   count, count ? div64_u64(total, count) : 0, atomic64_read(&stats[op].maxNs));
+        for (i = 0; i < STAT_BUCKETS; i++)
+        {
+            u64 n = atomic64_read(&stats[op].buckets[i]);
+            if (n == 0)
+                continue;
+            if (i == STAT_BUCKETS - 1)
+                seq_printf(file, "  %10llu+ ns: %llu\n", 1ULL << i, n);
+            else
+                seq_printf(file, "  %10llu-%llu ns: %llu\n", i ? 1ULL << i : 0, (2ULL << i) - 1, n);
+        }
+    }
+    return 0;
+}
+
+static int statsOpen(struct inode *inode, struct file *file)
+{
+    return single_open(file, statsShow, NULL);
+}
+
+static ssize_t statsWrite(struct file *file, const char __user *buffer, size_t count, loff_t *ppos)
+{
+    clearStats();
+    return count;
+}
+
+static const struct file_operations statsFops =
+{
+    .owner = THIS_MODULE,
+    .open = statsOpen,
+    .read = seq_read,
+    .write = statsWrite,
+    .llseek = seq_lseek,
+    .release = single_release
+};
+
+//-----------------------------------------------------------------------------
+// Stream ring
+//-----------------------------------------------------------------------------
+
+// Samples for MODE_STREAM go from a DMA-coherent ring in DDR, through an AXI
+// DMA MM2S channel (simple mode), to the stream FIFO in the IP. User space
+// maps the ring and fills it; between the start and stop ioctls a polling
+// hrtimer hands each filled span to the DMA and publishes the consumer index.
+// The FIFO back-pressures the DMA, so a transfer completes at the DAC rate.
+// The poll period is short enough that a quarter of the FIFO covers it at
+// the sample rate.
+
+// Xilinx AXI DMA MM2S registers (byte offsets)
+#define DMA_CR          0x00
+#define DMA_SR          0x04
+#define DMA_SA          0x18
+#define DMA_LENGTH      0x28
+#define DMA_CR_RS       (1 << 0)
+#define DMA_CR_RESET    (1 << 2)
+#define DMA_SR_HALTED   (1 << 0)
+#define DMA_SR_IDLE     (1 << 1)
+#define DMA_SR_ERRORS   (0x7 << 4)
+#define DMA_SR_IOC      (1 << 12)
+
+static ulong dmaBase = 0;
+module_param(dmaBase, ulong, 0444);
+MODULE_PARM_DESC(dmaBase, "Physical address of the AXI DMA feeding the stream input (e.g. 0x40400000), 0 disables streaming");
+
+static uint ringSize = 1 << 20;
+module_param(ringSize, uint, 0444);
+MODULE_PARM_DESC(ringSize, "Stream ring size in bytes, a power of two");
+
+static uint dmaMaxBytes = 16380;
+module_param(dmaMaxBytes, uint, 0444);
+MODULE_PARM_DESC(dmaMaxBytes, "Largest DMA transfer (the DMA's buffer length register limit)");
+
+static uint pollUs = 1000;
+module_param(pollUs, uint, 0444);
+MODULE_PARM_DESC(pollUs, "Longest stream ring poll period in us");
+
+static uint sampleRate = 50000;
+module_param(sampleRate, uint, 0444);
+MODULE_PARM_DESC(sampleRate, "Sample clock rate in Hz, sizes the stream poll period");
+
+static struct platform_device *dmaDevice;
+static void __iomem *dma;
+static struct wavegenRing *ring;    // control page, followed by the samples
+static dma_addr_t ringDma;
+static size_t ringBytes;            // whole allocation
+static u32 inflight;                // bytes of the transfer the DMA is running
+static bool streaming;
+static struct hrtimer streamTimer;
+static ktime_t pollPeriod;
+static DEFINE_MUTEX(streamLock);    // serializes start and stop
+
+static void dmaStart(void)
+{
+    int timeout = 1000;
+
+    iowrite32(DMA_CR_RESET, dma + DMA_CR);
+    while ((ioread32(dma + DMA_CR) & DMA_CR_RESET) && --timeout)
+        cpu_relax();
+    iowrite32(DMA_CR_RS, dma + DMA_CR);
+    inflight = 0;
+}
+
+static enum hrtimer_restart streamPoll(struct hrtimer *timer)
+{
+    u32 status, producer, consumer, fill, level, depth;
+
+    // Retire the finished transfer, recover from errors
+    status = ioread32(dma + DMA_SR);
+    if (status & DMA_SR_ERRORS)
+    {
+        WRITE_ONCE(ring->dmaErrors, ring->dmaErrors + 1);
+        dmaStart();
+    }
+    else if (inflight && (status & DMA_SR_IDLE))
+    {
+        iowrite32(DMA_SR_IOC, dma + DMA_SR);
+        smp_store_release(&ring->consumer, ring->consumer + inflight);
+        WRITE_ONCE(ring->transfers, ring->transfers + 1);
+        inflight = 0;
+    }
+
+    // Hand the next contiguous span of samples to the DMA
+    producer = smp_load_acquire(&ring->producer);
+    consumer = ring->consumer;
+    fill = producer - consumer;
+    if (inflight == 0 && fill >= 4)
+    {
+        u32 offset = consumer & (ring->size - 1);
+        u32 length = min3(fill, ring->size - offset, dmaMaxBytes) & ~3u;
+        iowrite32(ringDma + ring->dataOffset + offset, dma + DMA_SA);
+        iowrite32(length, dma + DMA_LENGTH);
+        inflight = length;
+    }
+
+    level = readReg(OFS_STREAM_LEVEL);
+    depth = level >> STREAM_DEPTH_SHIFT;
+    level &= STREAM_LEVEL_MASK;
+    if (!ring->playing && (level >= depth / 2 || (fill == 0 && inflight == 0 && level > 0)))
+    {
+        writeReg(STREAM_ENABLE, OFS_STREAM_CTRL);
+        WRITE_ONCE(ring->playing, 1);
+    }
+    else if (ring->playing && fill == 0)
+        WRITE_ONCE(ring->starved, ring->starved + 1);
+    WRITE_ONCE(ring->underruns, readReg(OFS_STREAM_UNDERRUN));
+
+    hrtimer_forward_now(timer, pollPeriod);
+    return HRTIMER_RESTART;
+}
+
+// Empties the FIFO and starts polling, the IP starts popping once the FIFO
+// is half full
+static void streamStart(void)
+{
+    u32 depth;
+    u64 periodNs;
+
+    mutex_lock(&streamLock);
+    if (!streaming)
+    {
+        writeReg(STREAM_FLUSH, OFS_STREAM_CTRL);
+        writeReg(0, OFS_STREAM_UNDERRUN);
+        dmaStart();
+        depth = readReg(OFS_STREAM_LEVEL) >> STREAM_DEPTH_SHIFT;
+        periodNs = div_u64((u64)depth / 4 * NSEC_PER_SEC, max(sampleRate, 1u));
+        pollPeriod = ns_to_ktime(clamp_t(u64, periodNs, 10 * NSEC_PER_USEC, (u64)pollUs * NSEC_PER_USEC));
+        WRITE_ONCE(ring->playing, 0);
+        WRITE_ONCE(ring->enable, 1);
+        streaming = true;
+        hrtimer_start(&streamTimer, pollPeriod, HRTIMER_MODE_REL);
+    }
+    mutex_unlock(&streamLock);
+}
+
+// Stops polling and drops everything queued: the FIFO, the DMA transfer and
+// the ring contents, by moving consumer up to producer
+static void streamStop(void)
+{
+    mutex_lock(&streamLock);
+    if (streaming)
+    {
+        hrtimer_cancel(&streamTimer);
+        writeReg(STREAM_FLUSH, OFS_STREAM_CTRL);
+        iowrite32(DMA_CR_RESET, dma + DMA_CR);
+        inflight = 0;
+        streaming = false;
+        WRITE_ONCE(ring->playing, 0);
+        WRITE_ONCE(ring->enable, 0);
+    }
+    smp_store_release(&ring->consumer, smp_load_acquire(&ring->producer));
+    mutex_unlock(&streamLock);
+}
+
+static int streamInit(void)
+{
+    int result;
+
+    if (dmaBase == 0 || !is_power_of_2(ringSize) || ringSize < PAGE_SIZE)
+        return -EINVAL;
+
+    dmaDevice = platform_device_register_simple("wavegen-stream", -1, NULL, 0);
+    if (IS_ERR(dmaDevice))
+        return PTR_ERR(dmaDevice);
+    result = dma_coerce_mask_and_coherent(&dmaDevice->dev, DMA_BIT_MASK(32));
+    if (result != 0)
+        goto unregister;
+
+    ringBytes = PAGE_SIZE + ringSize;
+    ring = dma_alloc_coherent(&dmaDevice->dev, ringBytes, &ringDma, GFP_KERNEL);
+    if (ring == NULL)
+    {
+        result = -ENOMEM;
+        goto unregister;
+    }
+    memset(ring, 0, PAGE_SIZE);
+    ring->size = ringSize;
+    ring->dataOffset = PAGE_SIZE;
+
+    dma = ioremap(dmaBase, PAGE_SIZE);
+    if (dma == NULL)
+    {
+        result = -ENODEV;
+        goto free;
+    }
+
+    hrtimer_init(&streamTimer, CLOCK_MONOTONIC, HRTIMER_MODE_REL);
+    streamTimer.function = streamPoll;
+    return 0;
+
+free:
+    dma_free_coherent(&dmaDevice->dev, ringBytes, ring, ringDma);
+    ring = NULL;
+unregister:
+    platform_device_unregister(dmaDevice);
+    return result;
+}
+
+static void streamExit(void)
+{
+    if (ring == NULL)
+        return;
+    streamStop();
+    iounmap(dma);
+    dma_free_coherent(&dmaDevice->dev, ringBytes, ring, ringDma);
+    platform_device_unregister(dmaDevice);
+}
+
+//-----------------------------------------------------------------------------
+// Character device
+//-----------------------------------------------------------------------------
+
+// /dev/wavegen maps the register page into user space, so processes in the
+// device's group get single-store access without /dev/mem. Set the group with
+// a udev rule, e.g. KERNEL=="wavegen", GROUP="wavegen"
+static ushort deviceMode = 0660;
+module_param(deviceMode, ushort, 0444);
+MODULE_PARM_DESC(deviceMode, "Permissions of /dev/wavegen");
+
+static int wavegenOpenDevice(struct inode *inode, struct file *file)
+{
+    trace_wavegen_entry("device", "open");
+    trace_wavegen_return("device", "open", 0, 0);
+    return 0;
+}
+
+// Offset MMAP_OFS_REGS is the register page, uncached, and MMAP_OFS_RING
+// the stream ring (control page and samples)
+static int wavegenMmap(struct file *file, struct vm_area_struct *vma)
+{
+    unsigned long size = vma->vm_end - vma->vm_start;
+    u64 start = ktime_get_ns();
+    int result;
+
+    trace_wavegen_entry("device", "mmap");
+    if (vma->vm_pgoff == MMAP_OFS_REGS && size <= PAGE_SIZE)
+    {
+        vma->vm_page_prot = pgprot_noncached(vma->vm_page_prot);
+        result = vm_iomap_memory(vma, AXI4_LITE_BASE + WAVEGEN_BASE_OFFSET, PAGE_SIZE);
+    }
+    else if (vma->vm_pgoff == MMAP_OFS_RING && ring != NULL && size <= ringBytes)
+    {
+        vma->vm_pgoff = 0;
+        result = dma_mmap_coherent(&dmaDevice->dev, vma, ring, ringDma, size);
+    }
+    else if (vma->vm_pgoff == MMAP_OFS_RING)
+        result = -ENODEV;
+    else
+        result = -EINVAL;
+    trace_wavegen_return("device", "mmap", result, ktime_get_ns() - start);
+    return result;
+}
+
+// Stream start and stop, both return once the driver has applied them
+static long wavegenIoctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+    u64 start = ktime_get_ns();
+    long result = 0;
+
+    trace_wavegen_entry("device", "ioctl");
+    if (cmd != WAVEGEN_IOC_STREAM_START && cmd != WAVEGEN_IOC_STREAM_STOP)
+        result = -ENOTTY;
+    else if (ring == NULL)
+        result = -ENODEV;
+    else if (cmd == WAVEGEN_IOC_STREAM_START)
+        streamStart();
+    else
+        streamStop();
+    trace_wavegen_return("device", "ioctl", result, ktime_get_ns() - start);
+    return result;
+}
+
+static const struct file_operations wavegenFops =
+{
+    .owner = THIS_MODULE,
+    .open = wavegenOpenDevice,
+    .mmap = wavegenMmap,
+    .unlocked_ioctl = wavegenIoctl
+};
+
+static struct miscdevice wavegenDevice =
+{
+    .minor = MISC_DYNAMIC_MINOR,
+    .name = "wavegen",
+    .fops = &wavegenFops
+};
+
 //-----------------------------------------------------------------------------
 // Initialization and Exit
 //-----------------------------------------------------------------------------
@@ -566,14 +1758,26 @@ static int __init initialize_module(void)
     printk(KERN_INFO "Wavegen driver: starting\n");
 
     // Create Wavegen directory under /sys/kernel
-    kobj = kobject_create_and_add("wavegen", NULL); // kernel_kobj);
+    kobj = kzalloc(sizeof(*kobj), GFP_KERNEL);
     if (!kobj)
+        return -ENOMEM;
+    result = kobject_init_and_add(kobj, &wavegenKtype, NULL, "wavegen"); // kernel_kobj);
+    if (result != 0)
     {
         printk(KERN_ALERT "Wavegen driver: failed to create and add kobj\n");
+        kobject_put(kobj);
         return -ENOENT;
     }
 
     // Create Wavegen groups
+    result = sysfs_create_group(kobj, &wavegen);
+    if (result != 0)
+    {
+        printk(KERN_ALERT "Wavegen driver: failed to create sysfs group\n");
+        kobject_put(kobj);
+        return result;
+    }
+
     result = sysfs_create_group(kobj, &channelA);
     if (result != 0)
     {
@@ -596,6 +1800,29 @@ static int __init initialize_module(void)
     if (base == NULL)
         return -ENODEV;
 
+    // Register page for mmap
+    wavegenDevice.mode = deviceMode;
+    result = misc_register(&wavegenDevice);
+    if (result != 0)
+    {
+        printk(KERN_ALERT "Wavegen driver: failed to register %s\n", WAVEGEN_DEVICE);
+        iounmap(base);
+        kobject_put(kobj);
+        return result;
+    }
+
+    // Stream ring, only with an AXI DMA configured; playback works without it
+    if (dmaBase != 0)
+    {
+        result = streamInit();
+        if (result != 0)
+            printk(KERN_WARNING "Wavegen driver: streaming unavailable (%d)\n", result);
+    }
+
+    // Statistics under /sys/kernel/debug/wavegen
+    debugDir = debugfs_create_dir("wavegen", NULL);
+    debugfs_create_file("stats", 0644, debugDir, NULL, &statsFops);
+
     printk(KERN_INFO "Wavegen driver: initialized\n");
 
     return 0;
@@ -603,7 +1830,11 @@ static int __init initialize_module(void)
 
 static void __exit exit_module(void)
 {
+    debugfs_remove_recursive(debugDir);
+    misc_deregister(&wavegenDevice);
+    streamExit();
     kobject_put(kobj);
+    iounmap(base);
     printk(KERN_INFO "Wavegen driver: exit\n");
 }
 
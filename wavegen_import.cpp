@@ -0,0 +1,560 @@
+// WAVEGEN IP Example
+// Arbitrary Waveform Importer (wavegen_import.cpp)
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Host PC (prepares tables for the Xilinx XUP Blackboard)
+
+// Converts a CSV or WAV capture of any length and sample rate into one period
+// of an arbitrary waveform table:
+//   - the input is memory mapped and parsed in a single pass
+//   - the capture is treated as one period, band-limited and resampled to the
+//     table length with a polyphase windowed-sinc filter (SIMD dot products)
+//   - the result is normalized and quantized to the 16-bit signed format of
+//     the IP, where +/-ONE_VOLT (2**15 - 1) is full scale (see Waveforms.sv)
+
+// Usage:
+//   wavegen_import INPUT.{csv|wav} OUTPUT.{bin|mem|coe|csv} [options]
+//     -n LENGTH   table length (default MAX_ARBITRARY_WAVEFORM_LENGTH)
+//     -c COLUMN   CSV column or WAV channel to use (default last CSV column,
+//                 first WAV channel)
+//     -p PEAK     normalized peak as a fraction of ONE_VOLT (default 1.0)
+//     -k          keep input scaling (1.0 = ONE_VOLT) instead of normalizing
+//     -z          remove the DC component before scaling
+
+//-----------------------------------------------------------------------------
+
+#include <algorithm>        // min, max, clamp
+#include <charconv>         // from_chars
+#include <chrono>           // steady_clock
+#include <cmath>            // sin, sqrt, lround
+#include <cstdint>          // C99 integer types
+#include <cstdio>           // printf, fopen
+#include <cstdlib>          // EXIT_ codes, strtol
+#include <cstring>          // strcmp, memcpy
+#include <strings.h>        // strcasecmp
+#include <numeric>          // gcd
+#include <string>
+#include <vector>
+#include <fcntl.h>          // open
+#include <sys/mman.h>       // mmap
+#include <sys/stat.h>       // fstat
+#include <unistd.h>         // close
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "wavegen_ip.h"     // MAX_ARBITRARY_WAVEFORM_LENGTH
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+// Full scale of a table sample (ONE_VOLT in Waveforms.sv)
+static const int ONE_VOLT = (1 << 15) - 1;
+
+// Filter design: zero crossings of the sinc on each side of the center,
+// Kaiser window shape, and passband as a fraction of the output Nyquist rate
+static const int FILTER_ZEROS = 16;
+static const double KAISER_BETA = 9.0;
+static const double PASSBAND = 0.9;
+
+// Timing resolution of the filter phases, in fractions of an output sample.
+// Exact polyphase is used when the ratio needs fewer phases than this.
+static const int PHASE_RESOLUTION = 1024;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+static double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Read-only memory map of an input file
+class MappedFile
+{
+public:
+    ~MappedFile()
+    {
+        if (data_ != nullptr)
+            munmap(const_cast<uint8_t *>(data_), size_);
+    }
+
+    bool open(const char *path)
+    {
+        int file = ::open(path, O_RDONLY);
+        if (file < 0)
+            return false;
+
+        struct stat info;
+        bool bOK = fstat(file, &info) == 0 && info.st_size > 0;
+        if (bOK)
+        {
+            size_ = info.st_size;
+            void *map = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, file, 0);
+            bOK = (map != MAP_FAILED);
+            if (bOK)
+            {
+                data_ = static_cast<const uint8_t *>(map);
+                madvise(map, size_, MADV_SEQUENTIAL);
+            }
+        }
+        close(file);
+        return bOK;
+    }
+
+    const uint8_t *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// CSV: one sample per line, fields separated by commas, semicolons or white
+// space. Lines whose selected field is not a number (headers, comments) are
+// skipped. A negative column selects the last field of each line.
+static bool readCsv(const MappedFile &file, int column, std::vector<float> &samples)
+{
+    const char *p = reinterpret_cast<const char *>(file.data());
+    const char *end = p + file.size();
+
+    samples.reserve(file.size() / 8);
+    while (p < end)
+    {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', end - p));
+        if (eol == nullptr)
+            eol = end;
+
+        double value = 0;
+        bool found = false;
+        int field = 0;
+        const char *q = p;
+        while (q < eol)
+        {
+            while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r'))
+                q++;
+            const char *start = q;
+            while (q < eol && *q != ',' && *q != ';' && *q != ' ' && *q != '\t' && *q != '\r')
+                q++;
+
+            if (column < 0 || field == column)
+            {
+                double v;
+                const char *number = (start < q && *start == '+') ? start + 1 : start;
+                auto result = std::from_chars(number, q, v);
+                found = (result.ec == std::errc() && result.ptr == q);
+                if (found)
+                    value = v;
+                if (column >= 0)
+                    break;
+            }
+            field++;
+
+            while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r'))
+                q++;
+            if (q < eol && (*q == ',' || *q == ';'))
+                q++;
+        }
+
+        if (found)
+            samples.push_back(static_cast<float>(value));
+        p = eol + 1;
+    }
+    return !samples.empty();
+}
+
+static uint16_t le16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static uint32_t le32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+// WAV: PCM 8/16/24/32-bit integer or 32/64-bit float, any channel count
+static bool readWav(const MappedFile &file, int channel, std::vector<float> &samples, uint32_t &rate)
+{
+    const uint8_t *p = file.data();
+    size_t size = file.size();
+    if (size < 12 || memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0)
+        return false;
+
+    uint16_t format = 0, channels = 0, bits = 0, blockAlign = 0;
+    const uint8_t *data = nullptr;
+    size_t dataSize = 0;
+
+    size_t ofs = 12;
+    while (ofs + 8 <= size && data == nullptr)
+    {
+        const uint8_t *chunk = p + ofs;
+        size_t chunkSize = le32(chunk + 4);
+        size_t available = size - ofs - 8;
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && available >= 16)
+        {
+            format = le16(chunk + 8);
+            channels = le16(chunk + 10);
+            rate = le32(chunk + 12);
+            blockAlign = le16(chunk + 20);
+            bits = le16(chunk + 22);
+            // WAVE_FORMAT_EXTENSIBLE keeps the real format in the sub-format GUID
+            if (format == 0xFFFE && chunkSize >= 40 && available >= 40)
+                format = le16(chunk + 32);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            data = chunk + 8;
+            dataSize = std::min(chunkSize, available);
+        }
+        ofs += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (data == nullptr || channels == 0 || blockAlign == 0 || channel >= channels)
+        return false;
+    if (!((format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+          (format == 3 && (bits == 32 || bits == 64))))
+        return false;
+
+    size_t count = dataSize / blockAlign;
+    size_t width = bits / 8;
+    const uint8_t *s = data + channel * width;
+    samples.resize(count);
+    for (size_t i = 0; i < count; i++, s += blockAlign)
+    {
+        float v;
+        if (format == 3 && bits == 32)
+        {
+            memcpy(&v, s, sizeof(v));
+        }
+        else if (format == 3)
+        {
+            double d;
+            memcpy(&d, s, sizeof(d));
+            v = static_cast<float>(d);
+        }
+        else if (bits == 8)
+            v = (s[0] - 128) / 128.0f;
+        else if (bits == 16)
+            v = static_cast<int16_t>(le16(s)) / 32768.0f;
+        else if (bits == 24)
+            v = (static_cast<int32_t>((s[0] << 8) | (s[1] << 16) | ((uint32_t)s[2] << 24)) >> 8) / 8388608.0f;
+        else
+            v = static_cast<int32_t>(le32(s)) / 2147483648.0f;
+        samples[i] = v;
+    }
+    return count > 0;
+}
+
+// Dot product of two float vectors, the inner loop of the filter
+static float dot(const float *a, const float *b, size_t n)
+{
+    size_t i = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    for (; i + 32 <= n; i += 32)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    for (; i + 8 <= n; i += 8)
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+    float sum = _mm_cvtss_f32(sum4);
+#elif defined(__SSE2__)
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 sum4 = _mm_add_ps(acc0, acc1);
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+    float sum = _mm_cvtss_f32(sum4);
+#else
+    float sum = 0;
+#endif
+    for (; i < n; i++)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+// Zeroth order modified Bessel function (Kaiser window)
+static double besselI0(double x)
+{
+    double sum = 1, term = 1;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; k++)
+    {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// Resamples one period of a periodic signal from inLength to outLength
+// samples. Output k sits at input position k*inLength/outLength; its integer
+// part selects the input window and its fraction selects a filter phase.
+class PolyphaseResampler
+{
+public:
+    PolyphaseResampler(size_t inLength, size_t outLength)
+        : inLength_(inLength), outLength_(outLength)
+    {
+        double ratio = (double)outLength / inLength;
+        double cutoff = 0.5 * std::min(1.0, ratio) * PASSBAND; // cycles per input sample
+        half_ = (int)std::ceil(FILTER_ZEROS / (2 * cutoff));
+        taps_ = 2 * half_ + 1;
+
+        // Exact phases when few enough, otherwise quantize the fraction
+        size_t exact = outLength / std::gcd(inLength, outLength);
+        size_t needed = std::max<size_t>(1, (size_t)std::ceil(PHASE_RESOLUTION * ratio));
+        exact_ = exact <= needed;
+        phases_ = exact_ ? exact : needed;
+
+        coefs_.resize(phases_ * taps_);
+        double window = half_ + 1;
+        double i0Beta = besselI0(KAISER_BETA);
+        for (size_t p = 0; p < phases_; p++)
+        {
+            float *row = &coefs_[p * taps_];
+            double frac = (double)p / phases_;
+            double sum = 0;
+            for (int j = 0; j < taps_; j++)
+            {
+                double t = j - half_ - frac;
+                double x = 2 * cutoff * t;
+                double sinc = (x == 0) ? 1 : std::sin(M_PI * x) / (M_PI * x);
+                double r = t / window;
+                double w = besselI0(KAISER_BETA * std::sqrt(std::max(0.0, 1 - r * r))) / i0Beta;
+                row[j] = (float)(sinc * w);
+                sum += row[j];
+            }
+            // Unity gain at DC for every phase
+            for (int j = 0; j < taps_; j++)
+                row[j] = (float)(row[j] / sum);
+        }
+    }
+
+    void process(const std::vector<float> &in, std::vector<float> &out) const
+    {
+        // Circularly extend the period so every window is contiguous
+        std::vector<float> ext(inLength_ + taps_);
+        for (size_t m = 0; m < ext.size(); m++)
+            ext[m] = in[(m + inLength_ * (half_ / inLength_ + 1) - half_) % inLength_];
+
+        out.resize(outLength_);
+        for (size_t k = 0; k < outLength_; k++)
+        {
+            uint64_t position = (uint64_t)k * inLength_;
+            size_t index = position / outLength_;
+            uint64_t frac = position % outLength_;
+            size_t phase;
+            if (exact_)
+                phase = frac * phases_ / outLength_;
+            else
+            {
+                phase = (frac * phases_ + outLength_ / 2) / outLength_;
+                if (phase == phases_)
+                {
+                    phase = 0;
+                    index++;
+                }
+            }
+            out[k] = dot(&ext[index], &coefs_[phase * taps_], taps_);
+        }
+    }
+
+    int taps() const { return taps_; }
+    size_t phases() const { return phases_; }
+    bool exact() const { return exact_; }
+
+private:
+    size_t inLength_, outLength_;
+    int half_, taps_;
+    size_t phases_;
+    bool exact_;
+    std::vector<float> coefs_;
+};
+
+static bool hasExtension(const char *path, const char *ext)
+{
+    size_t n = strlen(path), m = strlen(ext);
+    return n >= m && strcasecmp(path + n - m, ext) == 0;
+}
+
+static bool writeTable(const char *path, const std::vector<int16_t> &table)
+{
+    FILE *f = fopen(path, hasExtension(path, ".bin") ? "wb" : "w");
+    if (f == NULL)
+        return false;
+
+    if (hasExtension(path, ".bin"))
+    {
+        for (int16_t v : table)
+        {
+            uint8_t le[2] = {(uint8_t)(v & 0xFF), (uint8_t)((uint16_t)v >> 8)};
+            fwrite(le, 1, 2, f);
+        }
+    }
+    else if (hasExtension(path, ".mem"))
+    {
+        for (int16_t v : table)
+            fprintf(f, "%04X\n", (uint16_t)v);
+    }
+    else if (hasExtension(path, ".coe"))
+    {
+        fprintf(f, "memory_initialization_radix=16;\n");
+        fprintf(f, "memory_initialization_vector=\n");
+        for (size_t i = 0; i < table.size(); i++)
+            fprintf(f, "%04X%s\n", (uint16_t)table[i], i == table.size() - 1 ? "" : ",");
+        fprintf(f, ";\n");
+    }
+    else
+    {
+        for (size_t i = 0; i < table.size(); i++)
+            fprintf(f, "%zu,%d\n", i, table[i]);
+    }
+    return fclose(f) == 0;
+}
+
+static void usage()
+{
+    printf("  usage: wavegen_import INPUT.{csv|wav} OUTPUT.{bin|mem|coe|csv} [-n LENGTH] [-c COLUMN] [-p PEAK] [-k] [-z]\n");
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    const char *inPath = argv[1];
+    const char *outPath = argv[2];
+    size_t length = MAX_ARBITRARY_WAVEFORM_LENGTH;
+    int column = -1;
+    double peak = 1.0;
+    bool normalize = true;
+    bool removeDC = false;
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            length = strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            column = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            peak = atof(argv[++i]);
+        else if (strcmp(argv[i], "-k") == 0)
+            normalize = false;
+        else if (strcmp(argv[i], "-z") == 0)
+            removeDC = true;
+        else
+        {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (length == 0 || peak <= 0 || peak > 1)
+    {
+        printf("  table length must be positive and peak in (0, 1]\n");
+        return EXIT_FAILURE;
+    }
+
+    // Read
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file;
+    if (!file.open(inPath))
+    {
+        printf("  could not open %s\n", inPath);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<float> samples;
+    uint32_t rate = 0;
+    bool bOK;
+    if (hasExtension(inPath, ".wav"))
+        bOK = readWav(file, column < 0 ? 0 : column, samples, rate);
+    else
+        bOK = readCsv(file, column, samples);
+    if (!bOK)
+    {
+        printf("  no samples found in %s\n", inPath);
+        return EXIT_FAILURE;
+    }
+    double readMs = elapsedMs(start);
+
+    // Band-limit and resample
+    start = std::chrono::steady_clock::now();
+    PolyphaseResampler resampler(samples.size(), length);
+    std::vector<float> resampled;
+    resampler.process(samples, resampled);
+    double resampleMs = elapsedMs(start);
+
+    // Normalize and quantize
+    start = std::chrono::steady_clock::now();
+    double dc = 0;
+    for (float v : resampled)
+        dc += v;
+    dc /= length;
+
+    double offset = removeDC ? dc : 0;
+    double maxAbs = 0;
+    for (float v : resampled)
+        maxAbs = std::max(maxAbs, std::fabs(v - offset));
+
+    double scale = ONE_VOLT * peak;
+    if (normalize && maxAbs > 0)
+        scale /= maxAbs;
+
+    std::vector<int16_t> table(length);
+    size_t clipped = 0;
+    double maxError = 0, errorPower = 0, signalPower = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        double ideal = (resampled[i] - offset) * scale;
+        long q = std::lround(ideal);
+        if (q > ONE_VOLT || q < -ONE_VOLT)
+        {
+            q = std::clamp(q, (long)-ONE_VOLT, (long)ONE_VOLT);
+            clipped++;
+        }
+        table[i] = (int16_t)q;
+
+        double error = q - ideal;
+        maxError = std::max(maxError, std::fabs(error));
+        errorPower += error * error;
+        signalPower += ideal * ideal;
+    }
+    double quantizeMs = elapsedMs(start);
+
+    if (!writeTable(outPath, table))
+    {
+        printf("  could not write %s\n", outPath);
+        return EXIT_FAILURE;
+    }
+
+    // Report
+    printf("Input:     %zu samples", samples.size());
+    if (rate)
+        printf(" at %u Hz", rate);
+    printf(" (%.1f ms)\n", readMs);
+    printf("Resample:  %zu -> %zu, %d taps x %zu %s phases (%.1f ms)\n",
+        samples.size(), length, resampler.taps(), resampler.phases(),
+        resampler.exact() ? "exact" : "quantized", resampleMs);
+    printf("Scale:     %.3f LSB per unit, DC %.6f%s (%.1f ms)\n",
+        scale, dc, removeDC ? " removed" : "", quantizeMs);
+    printf("Quantize:  max error %.3f LSB, rms error %.3f LSB, SQNR %.1f dB, %zu clipped\n",
+        maxError, std::sqrt(errorPower / length),
+        errorPower > 0 ? 10 * std::log10(signalPower / errorPower) : INFINITY, clipped);
+    printf("Wrote %zu samples to %s\n", length, outPath);
+
+    return EXIT_SUCCESS;
+}
@@ -1,7 +1,16 @@
+#define _GNU_SOURCE                // pthread_attr_setaffinity_np
 #include <stdint.h>          // C99 integer types -- uint32_t
 #include <stdio.h>
+#include <stdlib.h>          // malloc, free
+#include <string.h>          // memset
+#include <math.h>            // sin
+#include <pthread.h>         // automation worker
+#include <sched.h>           // SCHED_FIFO, cpu_set_t
+#include <time.h>            // clock_nanosleep
 #include <stdbool.h>         // bool
+#include <errno.h>           // EINTR
 #include <fcntl.h>           // open
+#include <sys/ioctl.h>       // ioctl
 #include <sys/mman.h>        // mmap
 #include <unistd.h>          // close
 #include <strings.h>
@@ -15,14 +24,62 @@
 
 uint32_t *base = NULL;
 
+// Automation: each track is a curve, precomputed by automationStart into a
+// table of values, one per update, stored to its register with a single 16-
+// or 32-bit write
+#define MAX_AUTOMATION_TRACKS 6
+
+typedef struct
+{
+    volatile void *reg;
+    bool halfWord;
+    int curve;
+    int32_t from, to;
+    double period;
+    int32_t *table;         // copy of the CURVE_TABLE values
+    uint32_t tableLength;
+    int32_t *values;        // one per update at the automation rate
+    uint32_t length;
+} automationTrack;
+
+static automationTrack tracks[MAX_AUTOMATION_TRACKS];
+static int trackCount = 0;
+static pthread_t worker;
+static volatile bool automationRunning = false;
+static uint32_t automationRate = 0;
+static bool memoryLocked = false;  // mlockall by automationStart, undone by automationStop
+
+// Written by the worker, copied by automationGetStats; the lock inherits the
+// worker's priority so a reader never holds it up
+static automationStats stats;
+static pthread_mutex_t statsLock;
+
+// Stream ring shared with the driver
+static volatile struct wavegenRing *ring = NULL;
+static uint8_t *ringData = NULL;
+static int ringFile = -1;           // kept open for the start and stop ioctls
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
+// Maps the registers through the driver's /dev/wavegen (no root needed, only
+// access to the device), falling back to /dev/mem
 bool wavegenOpen()
 {
+    // Open /dev/wavegen
+    int file = open(WAVEGEN_DEVICE, O_RDWR);
+    if (file >= 0)
+    {
+        base = mmap(NULL, SPAN_IN_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED,
+                    file, MMAP_OFS_REGS);
+        close(file);
+        if (base != MAP_FAILED)
+            return true;
+    }
+
     // Open /dev/mem
-    int file = open("/dev/mem", O_RDWR | O_SYNC);
+    file = open("/dev/mem", O_RDWR | O_SYNC);
     bool bOK = (file >= 0);
     if (bOK)
     {
@@ -88,6 +145,8 @@ void configureWaveform(char *channel, int mode, uint32_t frequency, uint16_t amp
         case MODE_TRIANGLE: wave = "triangle"; break;
         case MODE_SQUARE:   wave = "square"; break; 
         case MODE_ARB:      wave = "arbitrary"; break;
+        case MODE_NOISE:    wave = "noise"; break;
+        case MODE_STREAM:   wave = "stream"; break;
         default:            wave = "error";
     }
 
@@ -108,27 +167,670 @@ void configureWaveform(char *channel, int mode, uint32_t frequency, uint16_t amp
             offset*1.0/10000, phase_offs*1.0/100);
 }
 
-void setCycles(char *channel, uint16_t cycles) 
+// Noise restarts from the seed every run; seed 0 selects the built-in seed
+void configureNoise(char *channel, uint16_t amplitude, int16_t offset, int shape, uint32_t seed)
 {
     int isChannelA = strcasecmp(channel, "a") == 0;
+    int modeShift = isChannelA ? 0 : 3;
     int valueShift = isChannelA ? 0 : 16;
 
-    *(base + OFS_CYCLES) &= ~(0xFFFF << valueShift);
-    *(base + OFS_CYCLES) |= (cycles << valueShift);
+    // clear previous settings
+    *(base + OFS_MODE) &= ~(0x7 << modeShift);
+    *(base + OFS_OFFSET) &= ~(0xFFFF << valueShift);
+    *(base + OFS_AMPLITUDE) &= ~(0xFFFF << valueShift);
+    *(base + OFS_NOISE) &= ~(NOISE_SHAPE_MASK << valueShift);
+
+    // set new configuration
+    *(base + (isChannelA ? OFS_NOISE_SEED_A : OFS_NOISE_SEED_B)) = seed;
+    *(base + OFS_NOISE) |= ((shape & NOISE_SHAPE_MASK) << valueShift);
+    *(base + OFS_OFFSET) |= ((uint16_t)offset << valueShift);
+    *(base + OFS_AMPLITUDE) |= (amplitude << valueShift);
+    *(base + OFS_MODE) |= (MODE_NOISE << modeShift);
+
+    char *name;
+    switch (shape)
+    {
+        case NOISE_PINK: name = "pink"; break;
+        case NOISE_BAND: name = "band-limited"; break;
+        default:         name = "white";
+    }
+    printf("Setting channel %s as %s noise, with amplitude %'.2fV, offset %'.2fV, seed 0x%08X\n",
+        isChannelA ? "A" : "B", name, amplitude*1.0/10000, offset*1.0/10000, seed);
+}
+
+void setCycles(char *channel, uint32_t cycles) 
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+
+    *(base + (isChannelA ? OFS_CYCLES_A : OFS_CYCLES_B)) = cycles;
 
     channel = isChannelA ? "A" : "B";
     if (cycles)
-        printf("Limiting channel %s to %d cycles", channel, cycles);
+        printf("Limiting channel %s to %u cycles\n", channel, cycles);
     else
-        printf("Setting channel %s to run forever", channel);
+        printf("Setting channel %s to run forever\n", channel);
 }
 
-void configureRun() 
+// Stops a burst stopPhase (units of 0.01 degrees, 0 to 35999) past its last
+// whole cycle, measured from the start of the burst
+void setStopPhase(char *channel, uint16_t stopPhase)
 {
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    int valueShift = isChannelA ? 0 : 16;
+    uint16_t fraction = ((uint32_t)stopPhase << 16) / 36000;
+
+    *(base + OFS_STOP_PHASE) &= ~(0xFFFF << valueShift);
+    *(base + OFS_STOP_PHASE) |= (fraction << valueShift);
+
+    printf("Stopping channel %s bursts %'.2f degrees into the last cycle\n",
+        isChannelA ? "A" : "B", stopPhase*1.0/100);
+}
+
+// Output level while a channel waits for a trigger or sync, or after a burst
+void setIdleLevel(char *channel, int16_t level)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    int valueShift = isChannelA ? 0 : 16;
+
+    *(base + OFS_IDLE) &= ~(0xFFFF << valueShift);
+    *(base + OFS_IDLE) |= ((uint16_t)level << valueShift);
+
+    printf("Setting channel %s idle level to %.2fV\n", isChannelA ? "A" : "B", (float)level/10000);
+}
+
+// With sync enabled the IP is armed first and RUN set once it reports armed,
+// so the outputs are gated until the shared sync edge (a master sends its
+// edge only after RUN is set); fails if the IP never reports armed
+bool configureRun()
+{
+    if (*(base + OFS_SYNC) & SYNC_MODE_MASK)
+    {
+        int timeout = 100000;
+        syncArm();
+        while (!(*(volatile uint32_t *)(base + OFS_SYNC) & SYNC_ARM) && --timeout)
+            ;
+        if (timeout == 0)
+            return false;
+    }
+
     *(base + OFS_RUN) = RUN_A | RUN_B;
+    return true;
 }
 
 void configureStop() 
 {
     *(base + OFS_RUN) = ~(RUN_A | RUN_B);
-}
\ No newline at end of file
+}
+
+void configureSync(int mode)
+{
+    *(base + OFS_SYNC) = mode & SYNC_MODE_MASK;
+
+    char *name;
+    switch (mode)
+    {
+        case SYNC_MASTER: name = "master"; break;
+        case SYNC_SLAVE:  name = "slave"; break;
+        default:          name = "off";
+    }
+    printf("Setting sync mode to %s\n", name);
+}
+
+// Slaves must be armed before the master, which sends the sync edge once it
+// is armed and RUN is set
+void syncArm()
+{
+    *(base + OFS_SYNC) = (*(base + OFS_SYNC) & SYNC_MODE_MASK) | SYNC_ARM;
+}
+
+// Source, edge and holdoff are shared by both channels; each channel is armed
+// separately and re-arms itself after every burst
+void configureTrigger(char *channel, int source, bool falling, uint32_t holdoff)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    uint32_t arm = (*(base + OFS_TRIG) & TRIG_ARM_MASK) | (isChannelA ? TRIG_ARM_A : TRIG_ARM_B);
+
+    *(base + OFS_HOLDOFF) = holdoff;
+    *(base + OFS_TRIG) = arm | ((source & TRIG_SRC_MASK) << TRIG_SRC_SHIFT) | (falling ? TRIG_FALLING : 0);
+
+    char *name;
+    switch (source)
+    {
+        case TRIGGER_SOFTWARE: name = "software"; break;
+        case TRIGGER_PIN:      name = "trigger pin"; break;
+        case TRIGGER_SYNC:     name = "sync input"; break;
+        default:               name = "error";
+    }
+    printf("Arming channel %s for a burst on each %s edge of the %s, holdoff %u samples\n",
+        isChannelA ? "A" : "B", falling ? "falling" : "rising", name, holdoff);
+}
+
+void disarmTrigger(char *channel)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+
+    *(base + OFS_TRIG) &= ~(isChannelA ? TRIG_ARM_A : TRIG_ARM_B);
+    printf("Disarming trigger on channel %s\n", isChannelA ? "A" : "B");
+}
+
+void softwareTrigger()
+{
+    *(base + OFS_TRIG) = (*(base + OFS_TRIG) & ~TRIG_FIRE) | TRIG_FIRE;
+}
+
+void getTriggerCounts(uint32_t *count, uint32_t *missed)
+{
+    *count = *(base + OFS_TRIG_COUNT);
+    *missed = *(base + OFS_TRIG_MISSED);
+}
+
+void clearTriggerCounts()
+{
+    *(base + OFS_TRIG_COUNT) = 0;
+}
+
+// Single-store setters, no read-modify-write and no printing, for use in loops
+void setAmplitude(char *channel, uint16_t amplitude)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    *((volatile uint16_t *)(base + OFS_AMPLITUDE) + (isChannelA ? 0 : 1)) = amplitude;
+}
+
+void setOffset(char *channel, int16_t offset)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    *((volatile uint16_t *)(base + OFS_OFFSET) + (isChannelA ? 0 : 1)) = (uint16_t)offset;
+}
+
+void setFrequency(char *channel, uint32_t frequency)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    *(volatile uint32_t *)(base + (isChannelA ? OFS_FREQ_A : OFS_FREQ_B)) = frequency;
+}
+
+// Adds a curve from 'from' to 'to' with the given period (seconds), sampled
+// at the rate later passed to automationStart:
+//   CURVE_RAMP  goes from 'from' to 'to' once per period, then restarts
+//   CURVE_STEP  holds 'from' for half a period, then 'to'
+//   CURVE_SINE  swings sinusoidally between 'from' and 'to' (AM, offset wobble)
+//   CURVE_TABLE plays table[] once per period, ignoring from and to
+bool automationAdd(char *channel, int param, int curve, int32_t from, int32_t to,
+                   double period, const int32_t *table, uint32_t tableLength)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    automationTrack *track;
+
+    if (automationRunning || trackCount == MAX_AUTOMATION_TRACKS || !(period > 0)
+        || curve < CURVE_RAMP || curve > CURVE_TABLE
+        || (curve == CURVE_TABLE && (table == NULL || tableLength == 0)))
+        return false;
+
+    track = &tracks[trackCount];
+    switch (param)
+    {
+        case PARAM_AMPLITUDE:
+            track->reg = (volatile uint16_t *)(base + OFS_AMPLITUDE) + (isChannelA ? 0 : 1);
+            track->halfWord = true;
+            break;
+        case PARAM_OFFSET:
+            track->reg = (volatile uint16_t *)(base + OFS_OFFSET) + (isChannelA ? 0 : 1);
+            track->halfWord = true;
+            break;
+        case PARAM_FREQUENCY:
+            track->reg = base + (isChannelA ? OFS_FREQ_A : OFS_FREQ_B);
+            track->halfWord = false;
+            break;
+        default:
+            return false;
+    }
+
+    track->table = NULL;
+    track->tableLength = 0;
+    if (curve == CURVE_TABLE)
+    {
+        track->table = malloc(tableLength * sizeof(int32_t));
+        if (track->table == NULL)
+            return false;
+        memcpy(track->table, table, tableLength * sizeof(int32_t));
+        track->tableLength = tableLength;
+    }
+    track->curve = curve;
+    track->from = from;
+    track->to = to;
+    track->period = period;
+    track->values = NULL;
+    track->length = 0;
+    trackCount++;
+    return true;
+}
+
+// Samples a track's curve at rate updates per second
+static bool buildTrack(automationTrack *track, uint32_t rate)
+{
+    uint32_t length = (uint32_t)(track->period * rate + 0.5);
+    int32_t from = track->from, to = track->to;
+    double span = (double)to - from;    // frequency spans overflow int32_t
+    uint32_t i;
+
+    if (length == 0)
+        return false;
+    track->values = malloc(length * sizeof(int32_t));
+    if (track->values == NULL)
+        return false;
+    track->length = length;
+
+    for (i = 0; i < length; i++)
+    {
+        double x = (double)i / length;
+        switch (track->curve)
+        {
+            case CURVE_RAMP:  track->values[i] = (int32_t)(from + span * x); break;
+            case CURVE_STEP:  track->values[i] = x < 0.5 ? from : to; break;
+            case CURVE_SINE:  track->values[i] = (int32_t)(from + span * (1 - cos(2 * M_PI * x)) / 2); break;
+            case CURVE_TABLE: track->values[i] = track->table[(uint64_t)i * track->tableLength / length]; break;
+        }
+    }
+    return true;
+}
+
+static void freeTracks()
+{
+    int t;
+    for (t = 0; t < trackCount; t++)
+    {
+        free(tracks[t].values);
+        free(tracks[t].table);
+        tracks[t].values = NULL;
+        tracks[t].table = NULL;
+    }
+}
+
+static void timespecAdd(struct timespec *t, uint64_t ns)
+{
+    t->tv_nsec += ns;
+    while (t->tv_nsec >= 1000000000)
+    {
+        t->tv_nsec -= 1000000000;
+        t->tv_sec++;
+    }
+}
+
+static int64_t timespecDiff(const struct timespec *a, const struct timespec *b)
+{
+    return (int64_t)(a->tv_sec - b->tv_sec) * 1000000000 + (a->tv_nsec - b->tv_nsec);
+}
+
+// Wakes at absolute deadlines so errors never accumulate, writes every track,
+// then records how late the write was against its deadline
+static void *automationWorker(void *arg)
+{
+    uint64_t period = 1000000000ULL / automationRate;
+    uint64_t index = 0;
+    struct timespec next, now, start;
+    int t;
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    next = start;
+    while (automationRunning)
+    {
+        int64_t late;
+
+        timespecAdd(&next, period);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR);
+
+        for (t = 0; t < trackCount; t++)
+        {
+            int32_t value = tracks[t].values[index % tracks[t].length];
+            if (tracks[t].halfWord)
+                *(volatile uint16_t *)tracks[t].reg = (uint16_t)value;
+            else
+                *(volatile uint32_t *)tracks[t].reg = (uint32_t)value;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        late = timespecDiff(&now, &next);
+        if (late < 0)
+            late = 0;
+        pthread_mutex_lock(&statsLock);
+        stats.updates++;
+        stats.totalLatencyNs += late;
+        if (late > (int64_t)stats.maxLatencyNs)
+            stats.maxLatencyNs = late;
+        stats.histogram[late / 1000 < AUTOMATION_HISTOGRAM_BINS ? late / 1000 : AUTOMATION_HISTOGRAM_BINS - 1]++;
+        stats.elapsedNs = timespecDiff(&now, &start);
+
+        // Missed whole periods are skipped, the curves stay on time
+        index++;
+        if (late >= (int64_t)period)
+        {
+            uint64_t missed = late / period;
+            stats.overruns += missed;
+            index += missed;
+            timespecAdd(&next, missed * period);
+        }
+        pthread_mutex_unlock(&statsLock);
+    }
+    return NULL;
+}
+
+// Starts the worker at rate updates per second. With cpu >= 0 it is pinned to
+// that core; priority > 0 runs it SCHED_FIFO (needs root or CAP_SYS_NICE).
+// For the best jitter boot with isolcpus=/nohz_full= on that core.
+bool automationStart(uint32_t rate, int cpu, int priority)
+{
+    pthread_attr_t attr;
+    pthread_mutexattr_t lockAttr;
+    struct sched_param param;
+    bool bOK;
+    int t;
+
+    if (automationRunning || trackCount == 0 || rate == 0 || rate > 1000000)
+        return false;
+
+    // Every track is sampled at this one rate
+    for (t = 0; t < trackCount; t++)
+    {
+        free(tracks[t].values);
+        tracks[t].values = NULL;
+        if (!buildTrack(&tracks[t], rate))
+            return false;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    automationRate = rate;
+
+    pthread_mutexattr_init(&lockAttr);
+    pthread_mutexattr_setprotocol(&lockAttr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&statsLock, &lockAttr);
+    pthread_mutexattr_destroy(&lockAttr);
+
+    // no page faults on the update path
+    memoryLocked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    if (!memoryLocked)
+        printf("Could not lock memory, updates may page fault\n");
+
+    pthread_attr_init(&attr);
+    if (priority > 0)
+    {
+        param.sched_priority = priority;
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    if (cpu >= 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+    }
+
+    automationRunning = true;
+    bOK = pthread_create(&worker, &attr, automationWorker, NULL) == 0;
+    if (!bOK && priority > 0)
+    {
+        printf("Could not start a SCHED_FIFO thread, running without real-time priority\n");
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        bOK = pthread_create(&worker, &attr, automationWorker, NULL) == 0;
+    }
+    pthread_attr_destroy(&attr);
+    automationRunning = bOK;
+    if (!bOK)
+    {
+        pthread_mutex_destroy(&statsLock);
+        if (memoryLocked)
+            munlockall();
+        memoryLocked = false;
+    }
+    return bOK;
+}
+
+// Copies the statistics so far, usable while the worker is running
+void automationGetStats(automationStats *out)
+{
+    if (automationRunning)
+    {
+        pthread_mutex_lock(&statsLock);
+        *out = stats;
+        pthread_mutex_unlock(&statsLock);
+    }
+    else
+        *out = stats;
+    out->rate = out->elapsedNs ? out->updates * 1e9 / out->elapsedNs : 0;
+}
+
+// Stops the worker, frees the tracks and returns the final statistics
+void automationStop(automationStats *out)
+{
+    if (automationRunning)
+    {
+        automationRunning = false;
+        pthread_join(worker, NULL);
+        pthread_mutex_destroy(&statsLock);
+    }
+    if (memoryLocked)
+        munlockall();
+    memoryLocked = false;
+    if (out != NULL)
+        automationGetStats(out);
+
+    freeTracks();
+    trackCount = 0;
+}
+
+// Plays the DMA sample stream on a channel, scaled like the other modes
+void configureStream(char *channel, uint16_t amplitude, int16_t offset)
+{
+    int isChannelA = strcasecmp(channel, "a") == 0;
+    int modeShift = isChannelA ? 0 : 3;
+    int valueShift = isChannelA ? 0 : 16;
+
+    // clear previous settings
+    *(base + OFS_MODE) &= ~(0x7 << modeShift);
+    *(base + OFS_OFFSET) &= ~(0xFFFF << valueShift);
+    *(base + OFS_AMPLITUDE) &= ~(0xFFFF << valueShift);
+
+    // set new configuration
+    *(base + OFS_OFFSET) |= ((uint16_t)offset << valueShift);
+    *(base + OFS_AMPLITUDE) |= (amplitude << valueShift);
+    *(base + OFS_MODE) |= (MODE_STREAM << modeShift);
+
+    printf("Setting channel %s to play the sample stream, with amplitude %'.2fV, offset %'.2fV\n",
+        isChannelA ? "A" : "B", amplitude*1.0/10000, offset*1.0/10000);
+}
+
+// Maps the driver's stream ring, needs /dev/wavegen and the AXI DMA
+bool streamOpen()
+{
+    long page = sysconf(_SC_PAGESIZE);
+    int file = open(WAVEGEN_DEVICE, O_RDWR);
+    bool bOK = (file >= 0);
+    if (bOK)
+    {
+        // Map the control page to learn the size, then the whole ring
+        struct wavegenRing *control = mmap(NULL, page, PROT_READ, MAP_SHARED, file, MMAP_OFS_RING * page);
+        bOK = (control != MAP_FAILED);
+        if (bOK)
+        {
+            size_t length = control->dataOffset + control->size;
+            munmap(control, page);
+
+            void *map = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, MMAP_OFS_RING * page);
+            bOK = (map != MAP_FAILED);
+            if (bOK)
+            {
+                ring = map;
+                ringData = (uint8_t *)map + ring->dataOffset;
+                ringFile = file;
+            }
+        }
+        if (!bOK)
+            close(file);
+    }
+    return bOK;
+}
+
+// Returns how many frames can be written contiguously at *frames; fill them
+// in place and publish them with streamCommit
+uint32_t streamAcquire(uint32_t **frames)
+{
+    uint32_t producer = ring->producer;
+    uint32_t consumer = __atomic_load_n(&ring->consumer, __ATOMIC_ACQUIRE);
+    uint32_t offset = producer & (ring->size - 1);
+    uint32_t space = ring->size - (producer - consumer);
+
+    *frames = (uint32_t *)(ringData + offset);
+    return (space < ring->size - offset ? space : ring->size - offset) / sizeof(uint32_t);
+}
+
+void streamCommit(uint32_t count)
+{
+    __atomic_store_n(&ring->producer, ring->producer + count * sizeof(uint32_t), __ATOMIC_RELEASE);
+}
+
+// Copies as many frames as fit without waiting, returns how many
+uint32_t streamWrite(const uint32_t *frames, uint32_t count)
+{
+    uint32_t written = 0;
+    while (written < count)
+    {
+        uint32_t *dest;
+        uint32_t n = streamAcquire(&dest);
+        if (n == 0)
+            break;
+        if (n > count - written)
+            n = count - written;
+        memcpy(dest, frames + written, n * sizeof(uint32_t));
+        streamCommit(n);
+        written += n;
+    }
+    return written;
+}
+
+// Playback starts once the IP's FIFO is half full, so prefill the ring first
+bool streamStart()
+{
+    return ioctl(ringFile, WAVEGEN_IOC_STREAM_START) == 0;
+}
+
+// Stops playback and drops every frame committed before the call; the driver
+// empties the ring before the ioctl returns, so frames written afterwards
+// are kept for the next start
+bool streamStop()
+{
+    return ioctl(ringFile, WAVEGEN_IOC_STREAM_STOP) == 0;
+}
+
+// Waits until every committed frame has been played
+void streamDrain()
+{
+    while (__atomic_load_n(&ring->consumer, __ATOMIC_ACQUIRE) != ring->producer && ring->enable)
+        usleep(1000);
+    while ((*(base + OFS_STREAM_LEVEL) & STREAM_LEVEL_MASK) != 0 && ring->enable)
+        usleep(1000);
+}
+
+void streamGetStatus(streamStatus *status)
+{
+    status->frames = ring->size / sizeof(uint32_t);
+    status->queued = (ring->producer - ring->consumer) / sizeof(uint32_t);
+    status->playing = ring->playing != 0;
+    status->underruns = ring->underruns;
+    status->starved = ring->starved;
+    status->dmaErrors = ring->dmaErrors;
+}
+
+// Presets: slots 0 to PRESET_STAGING - 1 each hold both channels' settings;
+// a recall switches all of them with one register write, at the next sample
+bool presetSave(int slot)
+{
+    if (slot < 0 || slot >= PRESET_STAGING)
+        return false;
+    *(volatile uint32_t *)(base + OFS_PRESET) = slot | PRESET_SAVE;
+    return true;
+}
+
+bool presetRecall(int slot)
+{
+    if (slot < 0 || slot >= PRESET_STAGING)
+        return false;
+    *(volatile uint32_t *)(base + OFS_PRESET) = slot | PRESET_RECALL;
+    return true;
+}
+
+// Writes the configuration, presets included, to a snapshot file
+bool snapshotSave(const char *path)
+{
+    static const int presetRegs[PRESET_WORDS] = PRESET_REGS;
+    volatile uint32_t *regs = base;
+    struct wavegenSnapshot snapshot;
+    int slot, i;
+
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.magic = SNAPSHOT_MAGIC;
+    snapshot.version = SNAPSHOT_VERSION;
+    snapshot.size = sizeof(snapshot);
+    for (i = 0; i < PRESET_WORDS; i++)
+        snapshot.channels[i] = *(regs + presetRegs[i]);
+    snapshot.sync = *(regs + OFS_SYNC) & SYNC_MODE_MASK;
+    snapshot.trigger = *(regs + OFS_TRIG) & (TRIG_ARM_MASK | (TRIG_SRC_MASK << TRIG_SRC_SHIFT) | TRIG_FALLING);
+    snapshot.holdoff = *(regs + OFS_HOLDOFF);
+    for (slot = 0; slot < PRESET_STAGING; slot++)
+        for (i = 0; i < PRESET_WORDS; i++)
+        {
+            *(regs + OFS_PRESET) = slot | (i << PRESET_INDEX_SHIFT);
+            snapshot.presets[slot][i] = *(regs + OFS_PRESET_DATA);
+        }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+        return false;
+    bool bOK = fwrite(&snapshot, sizeof(snapshot), 1, file) == 1;
+    return (fclose(file) == 0) && bOK;
+}
+
+// Restores a snapshot file in one step: the presets and the new channel
+// settings are loaded into the slots, then the staging slot is recalled and
+// the trigger and sync settings are restored
+bool snapshotLoad(const char *path)
+{
+    volatile uint32_t *regs = base;
+    struct wavegenSnapshot snapshot;
+    int slot, i;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return false;
+    bool bOK = fread(&snapshot, sizeof(snapshot), 1, file) == 1;
+    fclose(file);
+    if (!bOK || snapshot.magic != SNAPSHOT_MAGIC || snapshot.version < SNAPSHOT_VERSION
+        || snapshot.size < sizeof(snapshot))
+        return false;
+
+    for (slot = 0; slot < PRESET_STAGING; slot++)
+    {
+        *(regs + OFS_PRESET) = slot;
+        for (i = 0; i < PRESET_WORDS; i++)
+            *(regs + OFS_PRESET_DATA) = snapshot.presets[slot][i];
+    }
+    *(regs + OFS_PRESET) = PRESET_STAGING;
+    for (i = 0; i < PRESET_WORDS; i++)
+        *(regs + OFS_PRESET_DATA) = snapshot.channels[i];
+
+    *(regs + OFS_PRESET) = PRESET_STAGING | PRESET_RECALL;
+
+    // The recall is applied at the next sample clock
+    int timeout = 100;
+    while ((*(regs + OFS_PRESET) & PRESET_PENDING) && --timeout)
+        usleep(100);
+    if (timeout == 0)
+        return false;
+
+    // Trigger and sync settings (arm bits included) only after the recall,
+    // so an arm can never fire on the old channel settings
+    *(regs + OFS_HOLDOFF) = snapshot.holdoff;
+    *(regs + OFS_SYNC) = snapshot.sync & SYNC_MODE_MASK;
+    *(regs + OFS_TRIG) = snapshot.trigger & ~TRIG_FIRE;
+    return true;
+}
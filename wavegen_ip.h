@@ -40,12 +40,94 @@
 #define MODE_TRIANGLE   3
 #define MODE_SQUARE     4
 #define MODE_ARB        5
+#define MODE_NOISE      6
+#define MODE_STREAM     7
+
+#define NOISE_WHITE     0
+#define NOISE_PINK      1
+#define NOISE_BAND      2
+
+#define SYNC_OFF        0
+#define SYNC_MASTER     1
+#define SYNC_SLAVE      2
+
+#define TRIGGER_SOFTWARE 0
+#define TRIGGER_PIN      1
+#define TRIGGER_SYNC     2
+
+#define PARAM_AMPLITUDE 0
+#define PARAM_OFFSET    1
+#define PARAM_FREQUENCY 2
+
+#define CURVE_RAMP      0
+#define CURVE_STEP      1
+#define CURVE_SINE      2
+#define CURVE_TABLE     3
+
+// Update latency (time from the deadline to the register write) histogram,
+// 1 us per bin, the last bin counts everything later
+#define AUTOMATION_HISTOGRAM_BINS 100
+
+// Stream frames are one sample per channel, A in the low half
+#define STREAM_FRAME(a, b) ((uint32_t)(uint16_t)(a) | ((uint32_t)(uint16_t)(b) << 16))
+
+typedef struct
+{
+    uint64_t updates;
+    uint64_t overruns;       // whole update periods skipped
+    uint64_t elapsedNs;
+    uint64_t totalLatencyNs;
+    uint64_t maxLatencyNs;
+    double rate;             // achieved updates per second
+    uint32_t histogram[AUTOMATION_HISTOGRAM_BINS];
+} automationStats;
+
+typedef struct
+{
+    uint32_t frames;         // ring size in frames
+    uint32_t queued;         // frames written and not yet sent to the IP
+    bool playing;
+    uint32_t underruns;      // samples the IP missed with its FIFO empty
+    uint32_t starved;        // driver polls that found the ring empty while playing
+    uint32_t dmaErrors;
+} streamStatus;
 
 bool wavegenOpen();
 void configureDC(char *channel, int16_t offset);
 void configureWaveform(char *channel, int mode, uint32_t frequency, uint16_t amplitude, int16_t offset, uint16_t dutyCycle, int16_t phase_offs);
-void configureRun();
+bool configureRun();
 void configureStop();
-void setCycles(char *channel, uint16_t cycles);
+void configureNoise(char *channel, uint16_t amplitude, int16_t offset, int shape, uint32_t seed);
+void setCycles(char *channel, uint32_t cycles);
+void setStopPhase(char *channel, uint16_t stopPhase);
+void setIdleLevel(char *channel, int16_t level);
+void configureSync(int mode);
+void syncArm();
+void configureTrigger(char *channel, int source, bool falling, uint32_t holdoff);
+void disarmTrigger(char *channel);
+void softwareTrigger();
+void getTriggerCounts(uint32_t *count, uint32_t *missed);
+void clearTriggerCounts();
+void setAmplitude(char *channel, uint16_t amplitude);
+void setOffset(char *channel, int16_t offset);
+void setFrequency(char *channel, uint32_t frequency);
+bool automationAdd(char *channel, int param, int curve, int32_t from, int32_t to,
+                   double period, const int32_t *table, uint32_t tableLength);
+bool automationStart(uint32_t rate, int cpu, int priority);
+void automationGetStats(automationStats *stats);
+void automationStop(automationStats *stats);
+void configureStream(char *channel, uint16_t amplitude, int16_t offset);
+bool streamOpen();
+uint32_t streamAcquire(uint32_t **frames);
+void streamCommit(uint32_t count);
+uint32_t streamWrite(const uint32_t *frames, uint32_t count);
+bool streamStart();
+bool streamStop();
+void streamDrain();
+void streamGetStatus(streamStatus *status);
+bool presetSave(int slot);
+bool presetRecall(int slot);
+bool snapshotSave(const char *path);
+bool snapshotLoad(const char *path);
 
 #endif // WAVEGEN_IP_H
\ No newline at end of file
@@ -0,0 +1,277 @@
+// WAVEGEN IP Example
+// Bit-exact C++ models of the IP datapath (wavegen_model.h)
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Host PC (mirrors the HDL of the Xilinx XUP Blackboard IP)
+
+// Each model reproduces, sample for sample, the values the matching HDL
+// block registers on the sample clock. Keep them in step with the HDL.
+
+//-----------------------------------------------------------------------------
+
+#ifndef WAVEGEN_MODEL_H
+#define WAVEGEN_MODEL_H
+
+#include <cstdint>
+#include "wavegen_ip.h"     // MODE_ and NOISE_ values
+#include "sin_LUT.h"        // SIN_LUT, regenerate with coe.py with the LUT_ parameters
+
+//-----------------------------------------------------------------------------
+// Noise (NoiseGen.sv)
+//-----------------------------------------------------------------------------
+
+class NoiseModel
+{
+public:
+    static const uint32_t DEFAULT_SEED = 0x2545F491;
+
+    explicit NoiseModel(uint32_t seed = 0, int shape = NOISE_WHITE)
+    {
+        reset(seed, shape);
+    }
+
+    // Same as the generator while its channel is stopped or after a new seed
+    void reset(uint32_t seed, int shape)
+    {
+        state_ = (seed == 0) ? DEFAULT_SEED : seed;
+        shape_ = shape;
+        counter_ = 0;
+        for (int i = 0; i < 7; i++)
+            rows_[i] = 0;
+        lp_ = 0;
+        out_ = 0;
+    }
+
+    // WAVE value for the next sample clock of a channel running in MODE_NOISE
+    int16_t next()
+    {
+        int16_t out = out_;
+        step();
+        return out;
+    }
+
+    uint32_t state() const { return state_; }
+
+    // The generator after n samples, without stepping through all of them.
+    // xorshift32 is linear over GF(2), so its state jumps by powers of the
+    // step matrix. The pink rows are all rewritten within 128 samples. The
+    // band-limited filter is monotone in its state: runs started from both
+    // ends of its range that end up equal give the exact value for any start.
+    static NoiseModel at(uint32_t seed, int shape, uint64_t n)
+    {
+        for (uint64_t warmup = 256; ; warmup *= 2)
+        {
+            if (n <= warmup)
+            {
+                NoiseModel noise(seed, shape);
+                for (uint64_t i = 0; i < n; i++)
+                    noise.step();
+                return noise;
+            }
+
+            NoiseModel low(seed, shape);
+            low.state_ = jump(low.state_, n - warmup);
+            low.counter_ = (uint8_t)((n - warmup) & 0x7F);
+            NoiseModel high = low;
+            low.lp_ = INT16_MIN;
+            high.lp_ = INT16_MAX;
+            for (uint64_t i = 0; i < warmup; i++)
+            {
+                low.step();
+                high.step();
+            }
+            if (low.lp_ == high.lp_)
+                return low;
+        }
+    }
+
+private:
+    static uint32_t xorshift(uint32_t x)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+
+    // Columns of the step matrix raised to 2^k
+    struct JumpTable
+    {
+        uint32_t columns[64][32];
+
+        JumpTable()
+        {
+            for (int j = 0; j < 32; j++)
+                columns[0][j] = xorshift(1u << j);
+            for (int k = 1; k < 64; k++)
+                for (int j = 0; j < 32; j++)
+                    columns[k][j] = apply(k - 1, columns[k - 1][j]);
+        }
+
+        uint32_t apply(int k, uint32_t x) const
+        {
+            uint32_t y = 0;
+            for (int j = 0; x != 0; j++, x >>= 1)
+                if (x & 1)
+                    y ^= columns[k][j];
+            return y;
+        }
+    };
+
+    static uint32_t jump(uint32_t x, uint64_t n)
+    {
+        static const JumpTable table;
+        for (int k = 0; n != 0; k++, n >>= 1)
+            if (n & 1)
+                x = table.apply(k, x);
+        return x;
+    }
+
+    void step()
+    {
+        uint32_t x = xorshift(state_);
+        state_ = x;
+
+        int16_t white = (int16_t)(x >> 16);
+
+        counter_ = (counter_ + 1) & 0x7F;
+        uint8_t update = counter_ & -counter_;
+        int16_t rowValue = (int16_t)(x & 0xFFFF) >> 3;
+        int32_t pink = white >> 3;
+        for (int i = 0; i < 7; i++)
+        {
+            if (update & (1 << i))
+                rows_[i] = rowValue;
+            pink += rows_[i];
+        }
+
+        lp_ = (int16_t)(lp_ + ((white - lp_) >> 2));
+
+        switch (shape_)
+        {
+            case NOISE_PINK: out_ = (int16_t)pink; break;
+            case NOISE_BAND: out_ = lp_; break;
+            default:         out_ = white;
+        }
+    }
+
+    uint32_t state_;
+    int shape_;
+    uint8_t counter_;
+    int16_t rows_[7];
+    int16_t lp_;
+    int16_t out_;
+};
+
+//-----------------------------------------------------------------------------
+// Sine (SineWaves in sine.sv)
+//-----------------------------------------------------------------------------
+
+class SineModel
+{
+public:
+    // Output for a 32-bit phase (after the phase offset), top two bits select
+    // the quadrant and the next SIN_LUT_ADDR_WIDTH bits the table entry
+    static int16_t sample(uint32_t phase)
+    {
+        const uint32_t mask = (1u << SIN_LUT_ADDR_WIDTH) - 1;
+        bool sign = (phase >> 31) & 1;
+        bool mirror = (phase >> 30) & 1;
+        uint32_t index = (phase >> (30 - SIN_LUT_ADDR_WIDTH)) & mask;
+        uint16_t value = scale(SIN_LUT[mirror ? (~index & mask) : index]);
+        return sign ? (int16_t)-value : (int16_t)value;
+    }
+
+private:
+    // Entries are rescaled to the 16-bit datapath
+    static uint16_t scale(uint32_t entry)
+    {
+        if (SIN_LUT_DATA_WIDTH >= 16)
+            return (uint16_t)(entry >> (SIN_LUT_DATA_WIDTH - 16));
+        return (uint16_t)(entry << (16 - SIN_LUT_DATA_WIDTH));
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Phase increment and offset (PhaseScale.sv)
+//-----------------------------------------------------------------------------
+
+class PhaseScaleModel
+{
+public:
+    // floor(frequency * 2^32 / samplingFrequency), frequency in units of 100uHz
+    static uint32_t delta(uint32_t frequency, uint32_t samplingFrequency = 50000)
+    {
+        return (uint32_t)(((unsigned __int128)frequency << 32) / samplingFrequency);
+    }
+
+    // trunc(phaseOffset * 2^30 / 9000), phaseOffset in units of 0.01 degrees
+    static int32_t offset(int16_t phaseOffset)
+    {
+        uint32_t magnitude = (uint32_t)(((uint64_t)(phaseOffset < 0 ? -phaseOffset : phaseOffset) << 30) / 9000);
+        return (int32_t)(phaseOffset < 0 ? 0u - magnitude : magnitude);
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Output scaling (OutputStage.sv)
+//-----------------------------------------------------------------------------
+
+class OutputModel
+{
+public:
+    // OUT for one sample; the pipeline adds 4 clocks of latency
+    static int16_t sample(int16_t wave, int16_t amplitude, int16_t offset, int16_t idle,
+                          bool enable, bool active)
+    {
+        if (!enable)
+            return 0;
+        if (!active)
+            return idle;
+        int32_t sum = (((int32_t)wave * amplitude) >> 15) + offset;
+        if (sum > INT16_MAX)
+            return INT16_MAX;
+        if (sum < INT16_MIN)
+            return INT16_MIN;
+        return (int16_t)sum;
+    }
+};
+
+//-----------------------------------------------------------------------------
+// DAC calibration (voltsToDACWords in calibration.sv)
+//-----------------------------------------------------------------------------
+
+class CalibrationModel
+{
+public:
+    static const int GAIN_SHIFT = 24;
+
+    CalibrationModel(int dacTwoPointFive, int dacZero, int dacBits = 12)
+        : zero_(dacZero), max_((1 << dacBits) - 1)
+    {
+        int64_t span = dacTwoPointFive - dacZero;
+        gain_ = (span * (1LL << GAIN_SHIFT) + (span < 0 ? -12500 : 12500)) / 25000;
+    }
+
+    // DAC word for an output in units of 100uV, 2 clocks of latency
+    uint16_t word(int16_t out) const
+    {
+        int64_t scaled = (int64_t)out * gain_;
+        int64_t word = ((scaled + (1LL << (GAIN_SHIFT - 1))) >> GAIN_SHIFT) + zero_;
+        if (word < 0)
+            return 0;
+        if (word > max_)
+            return (uint16_t)max_;
+        return (uint16_t)word;
+    }
+
+private:
+    int64_t gain_;
+    int zero_;
+    int max_;
+};
+
+#endif // WAVEGEN_MODEL_H
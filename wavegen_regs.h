@@ -18,6 +18,8 @@
 #ifndef WAVEGEN_REGS_H_
 #define WAVEGEN_REGS_H_
 
+#include <linux/ioctl.h>    // _IO
+
 #define OFS_MODE        0
 #define OFS_RUN         1
 #define OFS_FREQ_A      2
@@ -27,6 +29,23 @@
 #define OFS_DTYCYC      6
 #define OFS_CYCLES      7
 #define OFS_PHASE_OFFS  8
+#define OFS_SYNC        9
+#define OFS_TRIG        10
+#define OFS_HOLDOFF     11
+#define OFS_TRIG_COUNT  12
+#define OFS_TRIG_MISSED 13
+#define OFS_NOISE       14
+#define OFS_NOISE_SEED_A 15
+#define OFS_NOISE_SEED_B 16
+#define OFS_CYCLES_A    17
+#define OFS_CYCLES_B    18
+#define OFS_STOP_PHASE  19
+#define OFS_IDLE        20
+#define OFS_STREAM_CTRL 21
+#define OFS_STREAM_LEVEL 22
+#define OFS_STREAM_UNDERRUN 23
+#define OFS_PRESET      24
+#define OFS_PRESET_DATA 25
 
 
 #define MMODE_MASK       0x7
@@ -39,8 +58,89 @@
 #define CYCLES_MASK     0xFF
 #define PHASE_OFFS_MASK 0xFF
 #define OFFSET_MASK     0xFF
+#define SYNC_MODE_MASK  0x3
+#define SYNC_ARM        (1 << 2)
+#define TRIG_ARM_MASK   0x3
+#define TRIG_ARM_A      (1 << 0)
+#define TRIG_ARM_B      (1 << 1)
+#define TRIG_SRC_MASK   0x3
+#define TRIG_SRC_SHIFT  2
+#define TRIG_FALLING    (1 << 4)
+#define TRIG_FIRE       (1 << 5)
+#define NOISE_SHAPE_MASK 0x3
+#define STREAM_ENABLE   (1 << 0)
+#define STREAM_FLUSH    (1 << 1)
+#define STREAM_LEVEL_MASK 0xFFFF
+#define STREAM_DEPTH_SHIFT 16
+#define PRESET_SLOT_MASK 0x7
+#define PRESET_SAVE     (1 << 4)
+#define PRESET_RECALL   (1 << 5)
+#define PRESET_PENDING  (1 << 5)
+#define PRESET_INDEX_SHIFT 8
+#define PRESET_SLOTS_SHIFT 16
+#define PRESET_RECALLED_SHIFT 24
+
+#define SPAN_IN_BYTES 104
+
+// Preset slots hold the channel settings, PRESET_WORDS register images in
+// PRESET_REGS order. The last slot stages snapshot restores, so its contents
+// are not kept
+#define PRESET_SLOTS    8
+#define PRESET_STAGING  (PRESET_SLOTS - 1)
+#define PRESET_WORDS    15
+#define PRESET_REGS     {OFS_MODE, OFS_RUN, OFS_FREQ_A, OFS_FREQ_B, OFS_OFFSET, OFS_AMPLITUDE, \
+                         OFS_DTYCYC, OFS_PHASE_OFFS, OFS_NOISE, OFS_NOISE_SEED_A, OFS_NOISE_SEED_B, \
+                         OFS_CYCLES_A, OFS_CYCLES_B, OFS_STOP_PHASE, OFS_IDLE}
+
+// Character device exported by wavegen_driver, mmap offsets (in pages) select
+// the region, ioctls start and stop the stream
+#define WAVEGEN_DEVICE  "/dev/wavegen"
+#define MMAP_OFS_REGS   0           // register page, read/write
+#define MMAP_OFS_RING   1           // stream ring: struct wavegenRing, then the samples
+#define WAVEGEN_IOC_MAGIC        'w'
+#define WAVEGEN_IOC_STREAM_START _IO(WAVEGEN_IOC_MAGIC, 1)
+#define WAVEGEN_IOC_STREAM_STOP  _IO(WAVEGEN_IOC_MAGIC, 2)
+
+// Stream ring shared by the driver and user space. The samples are 32-bit
+// frames, {B[31:16], A[15:0]}, starting dataOffset bytes into the mapping.
+// producer and consumer are free-running byte counts (fill = producer -
+// consumer, size is a power of two); user space only writes producer, the
+// driver only consumer and the counters. WAVEGEN_IOC_STREAM_STOP empties the
+// ring by moving consumer up to producer before it returns, so frames
+// committed before the stop are dropped and frames committed after it are
+// played at the next start.
+struct wavegenRing
+{
+    uint32_t size;          // bytes of sample data
+    uint32_t dataOffset;    // bytes from the start of the mapping to the samples
+    uint32_t producer;      // bytes written by user space
+    uint32_t consumer;      // bytes handed to the DMA and completed, or dropped
+    uint32_t enable;        // the driver is feeding the DMA (between start and stop)
+    uint32_t playing;       // the IP is popping samples
+    uint32_t underruns;     // samples the IP missed with its FIFO empty
+    uint32_t starved;       // polls that found the ring empty while playing
+    uint32_t transfers;     // DMA transfers completed
+    uint32_t dmaErrors;     // DMA errors (the DMA is reset and playback continues)
+};
+
+// Configuration snapshot, read and written whole through the driver's
+// snapshot attribute or saved to a file by the library. Status registers
+// (trigger counts, stream level and underruns) and stream playback are not
+// part of it. Later versions only append fields, size tells them apart.
+#define SNAPSHOT_MAGIC   0x4E534757 // "WGSN"
+#define SNAPSHOT_VERSION 1
 
-#define SPAN_IN_BYTES 36
+struct wavegenSnapshot
+{
+    uint32_t magic;                 // SNAPSHOT_MAGIC
+    uint16_t version;               // SNAPSHOT_VERSION
+    uint16_t size;                  // bytes, sizeof(struct wavegenSnapshot)
+    uint32_t channels[PRESET_WORDS];    // live channel settings, PRESET_REGS order
+    uint32_t sync;                  // sync mode
+    uint32_t trigger;               // trigger arm, source and edge
+    uint32_t holdoff;
+    uint32_t presets[PRESET_STAGING][PRESET_WORDS];
+};
 
 #endif
 
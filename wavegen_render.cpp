@@ -0,0 +1,464 @@
+// WAVEGEN IP Example
+// Offline Waveform Renderer (wavegen_render.cpp)
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Host PC or Xilinx XUP Blackboard (no hardware access)
+
+// Renders what the IP would output for a set of wavegen commands, sample for
+// sample, using the bit-exact models in wavegen_model.h:
+//   - OUT_A/OUT_B, the 16-bit output words (units of 100uV)
+//   - DAC_A/DAC_B, the 12-bit DAC codes after voltsToDACWords (WaveGen.sv)
+// Both channels start together at sample 0, as after "wavegen run" with no
+// trigger or sync armed.
+//
+// The render is split into blocks spread over all cores. Every block starts
+// from the phase accumulator position it would have reached in hardware
+// (sample index times phase increment), noise blocks from the generator state
+// jumped ahead to the block (NoiseModel::at). Raw and WAV output is written
+// in place through mmap, CSV is formatted per block and written in order.
+
+// Usage:
+//   wavegen render FILE.{raw|wav|csv} SECONDS COMMAND [-- COMMAND ...]
+// where each COMMAND is one of
+//   dc OUT OFS
+//   {sine|sawtooth|triangle|square} OUT FREQ AMP [OFS] [PHASE_OFFS] [DTCYC]
+//   noise OUT AMP [OFS] [white|pink|band] [SEED]
+//   cycles OUT {N [STOP_PHASE]|continuous}
+//   idle OUT LEVEL
+// Raw files hold little-endian int16 OUT_A, OUT_B and uint16 DAC_A, DAC_B
+// per sample; WAV files the same four channels at the sample rate.
+
+//-----------------------------------------------------------------------------
+
+#include <algorithm>        // min
+#include <atomic>
+#include <charconv>         // to_chars
+#include <chrono>           // steady_clock
+#include <cstdint>          // C99 integer types
+#include <cstdio>           // printf, fopen
+#include <cstdlib>          // EXIT_ codes, strtoul
+#include <cstring>          // strcmp, memcpy
+#include <strings.h>        // strcasecmp
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>          // open
+#include <sys/mman.h>       // mmap
+#include <unistd.h>         // ftruncate, close
+#include "wavegen_model.h"  // bit-exact models
+#include "wavegen_render.h"
+
+//-----------------------------------------------------------------------------
+// Defines
+//-----------------------------------------------------------------------------
+
+// SAMPLING_FREQUENCY of the IP (wavegen_v1_0.v)
+static const uint32_t SAMPLE_RATE = 50000;
+
+// Calibration of the DAC channels (voltsToDACWords instances in WaveGen.sv)
+static const int DAC_A_TWOPOINTFIVE = 135, DAC_A_ZERO = 2079;
+static const int DAC_B_TWOPOINTFIVE = 134, DAC_B_ZERO = 2071;
+
+// Samples per block of work
+static const uint64_t BLOCK_SAMPLES = 1 << 20;
+
+// Bytes per sample in raw and WAV files
+static const int FRAME_BYTES = 8;
+static const int WAV_HEADER_BYTES = 44;
+
+static const int ONE_VOLT = (1 << 15) - 1;
+
+//-----------------------------------------------------------------------------
+// Channel model
+//-----------------------------------------------------------------------------
+
+// Settings of one channel, in register units, and what follows from them
+struct Channel
+{
+    int mode = MODE_DC;
+    uint32_t frequency = 0;
+    int16_t amplitude = 0;
+    int16_t offset = 0;
+    int16_t phaseOffs = 0;
+    uint16_t dutyCycle = 32768;
+    uint32_t cycles = 0;
+    uint16_t stop = 0;
+    int16_t idle = 0;
+    int noiseShape = NOISE_WHITE;
+    uint32_t seed = 0;
+
+    uint32_t delta = 0;
+    int32_t phaseOffset = 0;
+    uint64_t doneAt = UINT64_MAX;   // first sample at the idle level
+
+    void prepare()
+    {
+        delta = PhaseScaleModel::delta(frequency, SAMPLE_RATE);
+        phaseOffset = PhaseScaleModel::offset(phaseOffs);
+
+        // A burst is done once the accumulator has advanced cycles whole
+        // cycles plus stop/2^16 of one; sample j is output while the state
+        // after j steps is not done, so a burst shows exactly steps samples
+        doneAt = UINT64_MAX;
+        if ((cycles != 0 || stop != 0) && delta != 0)
+        {
+            unsigned __int128 limit = ((unsigned __int128)cycles << 32) + ((uint64_t)stop << 16);
+            unsigned __int128 steps = (limit + delta - 1) / delta;
+            doneAt = steps > UINT64_MAX ? UINT64_MAX : (uint64_t)steps;
+        }
+    }
+
+    // WAVE for a phase (after the offset), as in WaveForms.sv
+    int16_t wave(uint32_t phase) const
+    {
+        switch (mode)
+        {
+            case MODE_SINE:
+                return SineModel::sample(phase);
+            case MODE_SAWTOOTH:
+                return (int16_t)(phase < (1u << 31) ? (int32_t)(phase >> 16) : (int32_t)(phase >> 16) - 65535);
+            case MODE_TRIANGLE:
+                if (phase < (1u << 30))
+                    return (int16_t)(phase >> 15);
+                if (phase < 3u * (1u << 30))
+                    return (int16_t)(65535 - (int32_t)(phase >> 15));
+                return (int16_t)((int32_t)(phase >> 15) - 131070);
+            case MODE_SQUARE:
+                return phase >= ((uint32_t)dutyCycle << 16) ? -ONE_VOLT : ONE_VOLT;
+            default:
+                return 0;
+        }
+    }
+};
+
+// Renders samples [first, first + count) of one channel
+static void renderChannel(const Channel &channel, NoiseModel noise, uint64_t first, uint64_t count,
+                          int16_t *out)
+{
+    uint32_t phase = (uint32_t)(first * channel.delta);
+    for (uint64_t i = 0; i < count; i++)
+    {
+        uint64_t j = first + i;
+        if (j >= channel.doneAt)
+        {
+            out[i] = OutputModel::sample(0, 0, 0, channel.idle, true, false);
+            continue;
+        }
+        int16_t wave = (channel.mode == MODE_NOISE) ? noise.next() : channel.wave(phase + channel.phaseOffset);
+        out[i] = OutputModel::sample(wave, channel.amplitude, channel.offset, channel.idle, true, true);
+        phase += channel.delta;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Command parsing
+//-----------------------------------------------------------------------------
+
+static Channel *selectChannel(Channel channels[2], const char *name)
+{
+    if (strcasecmp(name, "a") == 0)
+        return &channels[0];
+    if (strcasecmp(name, "b") == 0)
+        return &channels[1];
+    return NULL;
+}
+
+// Same arguments as the live commands in wavegen.c
+static bool parseCommand(int argc, char *argv[], Channel channels[2])
+{
+    if (argc < 3)
+        return false;
+    Channel *ch = selectChannel(channels, argv[1]);
+    if (ch == NULL)
+        return false;
+
+    if (argc == 3 && strcasecmp(argv[0], "dc") == 0)
+    {
+        ch->mode = MODE_DC;
+        ch->offset = atoi(argv[2]);
+    }
+    else if ((argc == 3 || argc == 4) && strcmp(argv[0], "cycles") == 0)
+    {
+        if (strcmp(argv[2], "continuous") == 0)
+        {
+            ch->cycles = 0;
+            ch->stop = 0;
+        }
+        else
+        {
+            ch->cycles = strtoul(argv[2], NULL, 0);
+            ch->stop = ((uint32_t)(argc > 3 ? atoi(argv[3]) : 0) << 16) / 36000;
+        }
+    }
+    else if (argc == 3 && strcmp(argv[0], "idle") == 0)
+        ch->idle = atoi(argv[2]);
+    else if (argc >= 3 && argc <= 6 && strcmp(argv[0], "noise") == 0)
+    {
+        ch->mode = MODE_NOISE;
+        ch->amplitude = atoi(argv[2]);
+        ch->offset = argc > 3 ? atoi(argv[3]) : 0;
+        ch->noiseShape = NOISE_WHITE;
+        if (argc > 4 && strcmp(argv[4], "pink") == 0)
+            ch->noiseShape = NOISE_PINK;
+        else if (argc > 4 && strcmp(argv[4], "band") == 0)
+            ch->noiseShape = NOISE_BAND;
+        ch->seed = argc > 5 ? strtoul(argv[5], NULL, 0) : 0;
+    }
+    else if (argc >= 4 && argc <= 7)
+    {
+        if (strcmp(argv[0], "sine") == 0)
+            ch->mode = MODE_SINE;
+        else if (strcmp(argv[0], "sawtooth") == 0)
+            ch->mode = MODE_SAWTOOTH;
+        else if (strcmp(argv[0], "triangle") == 0)
+            ch->mode = MODE_TRIANGLE;
+        else if (strcmp(argv[0], "square") == 0)
+            ch->mode = MODE_SQUARE;
+        else
+            return false;
+        ch->frequency = atoi(argv[2]);
+        ch->amplitude = atoi(argv[3]);
+        ch->offset = argc > 4 ? atoi(argv[4]) : 0;
+        ch->phaseOffs = argc > 5 ? atoi(argv[5]) : 0;
+        ch->dutyCycle = argc > 6 ? atoi(argv[6]) : 32768;
+    }
+    else
+        return false;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Output
+//-----------------------------------------------------------------------------
+
+static bool hasExtension(const char *path, const char *ext)
+{
+    size_t n = strlen(path), m = strlen(ext);
+    return n >= m && strcasecmp(path + n - m, ext) == 0;
+}
+
+static void put16(uint8_t *p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static void put32(uint8_t *p, uint32_t v) { put16(p, v & 0xFFFF); put16(p + 2, v >> 16); }
+
+static void writeWavHeader(uint8_t *p, uint64_t samples)
+{
+    uint32_t dataBytes = (uint32_t)(samples * FRAME_BYTES);
+    memcpy(p, "RIFF", 4);
+    put32(p + 4, 36 + dataBytes);
+    memcpy(p + 8, "WAVEfmt ", 8);
+    put32(p + 16, 16);                          // fmt chunk size
+    put16(p + 20, 1);                           // PCM
+    put16(p + 22, 4);                           // OUT_A, OUT_B, DAC_A, DAC_B
+    put32(p + 24, SAMPLE_RATE);
+    put32(p + 28, SAMPLE_RATE * FRAME_BYTES);   // bytes per second
+    put16(p + 32, FRAME_BYTES);                 // block align
+    put16(p + 34, 16);                          // bits per sample
+    memcpy(p + 36, "data", 4);
+    put32(p + 40, dataBytes);
+}
+
+// One block of both channels and their DAC codes
+struct Block
+{
+    std::vector<int16_t> outA, outB;
+
+    void render(const Channel channels[2], uint64_t first, uint64_t count)
+    {
+        outA.resize(count);
+        outB.resize(count);
+        renderChannel(channels[0], noiseAt(channels[0], first), first, count, outA.data());
+        renderChannel(channels[1], noiseAt(channels[1], first), first, count, outB.data());
+    }
+
+    // The noise generator steps once per sample until the burst is done
+    static NoiseModel noiseAt(const Channel &channel, uint64_t first)
+    {
+        if (channel.mode != MODE_NOISE)
+            return NoiseModel(channel.seed, channel.noiseShape);
+        return NoiseModel::at(channel.seed, channel.noiseShape, std::min(first, channel.doneAt));
+    }
+};
+
+static void formatFrames(const Block &block, const CalibrationModel dac[2], uint8_t *p)
+{
+    for (size_t i = 0; i < block.outA.size(); i++, p += FRAME_BYTES)
+    {
+        put16(p, (uint16_t)block.outA[i]);
+        put16(p + 2, (uint16_t)block.outB[i]);
+        put16(p + 4, dac[0].word(block.outA[i]));
+        put16(p + 6, dac[1].word(block.outB[i]));
+    }
+}
+
+template <typename T>
+static void appendNumber(std::string &text, T value, char separator)
+{
+    char digits[24];
+    char *end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    text.append(digits, end - digits);
+    text.push_back(separator);
+}
+
+static void formatCsv(const Block &block, const CalibrationModel dac[2], uint64_t first, std::string &text)
+{
+    text.clear();
+    text.reserve(block.outA.size() * 32);
+    for (size_t i = 0; i < block.outA.size(); i++)
+    {
+        appendNumber(text, first + i, ',');
+        appendNumber(text, block.outA[i], ',');
+        appendNumber(text, block.outB[i], ',');
+        appendNumber(text, dac[0].word(block.outA[i]), ',');
+        appendNumber(text, dac[1].word(block.outB[i]), '\n');
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Render
+//-----------------------------------------------------------------------------
+
+static void usage()
+{
+    printf("  usage: wavegen render FILE.{raw|wav|csv} SECONDS COMMAND [-- COMMAND ...]\n");
+}
+
+int wavegenRender(int argc, char *argv[])
+{
+    if (argc < 5)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+    const char *path = argv[1];
+    double seconds = atof(argv[2]);
+    uint64_t samples = (uint64_t)(seconds * SAMPLE_RATE + 0.5);
+
+    // Commands are separated by --
+    Channel channels[2];
+    for (int i = 3; i < argc; )
+    {
+        int end = i;
+        while (end < argc && strcmp(argv[end], "--") != 0)
+            end++;
+        if (!parseCommand(end - i, argv + i, channels))
+        {
+            printf("  command not understood:");
+            for (int k = i; k < end; k++)
+                printf(" %s", argv[k]);
+            printf("\n");
+            return EXIT_FAILURE;
+        }
+        i = end + 1;
+    }
+    for (Channel &ch : channels)
+        ch.prepare();
+    if (samples == 0)
+    {
+        printf("  nothing to render\n");
+        return EXIT_FAILURE;
+    }
+
+    bool wav = hasExtension(path, ".wav");
+    bool csv = hasExtension(path, ".csv");
+    if (wav && samples * FRAME_BYTES > UINT32_MAX - WAV_HEADER_BYTES)
+    {
+        printf("  too long for a WAV file, use .raw or .csv\n");
+        return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t blocks = (samples + BLOCK_SAMPLES - 1) / BLOCK_SAMPLES;
+
+    const CalibrationModel dac[2] = {
+        CalibrationModel(DAC_A_TWOPOINTFIVE, DAC_A_ZERO),
+        CalibrationModel(DAC_B_TWOPOINTFIVE, DAC_B_ZERO)
+    };
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<uint64_t> nextBlock(0);
+    bool bOK = true;
+
+    if (!csv)
+    {
+        // Raw and WAV: every block has a fixed place in the file
+        size_t header = wav ? WAV_HEADER_BYTES : 0;
+        size_t bytes = header + samples * FRAME_BYTES;
+        int file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file < 0 || ftruncate(file, bytes) != 0)
+        {
+            printf("  could not create %s\n", path);
+            if (file >= 0)
+                close(file);
+            return EXIT_FAILURE;
+        }
+        uint8_t *map = (uint8_t *)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        close(file);
+        if (map == MAP_FAILED)
+        {
+            printf("  could not map %s\n", path);
+            return EXIT_FAILURE;
+        }
+        if (wav)
+            writeWavHeader(map, samples);
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++)
+            workers.emplace_back([&]()
+            {
+                Block block;
+                for (uint64_t b; (b = nextBlock++) < blocks; )
+                {
+                    uint64_t first = b * BLOCK_SAMPLES;
+                    block.render(channels, first, std::min(BLOCK_SAMPLES, samples - first));
+                    formatFrames(block, dac, map + header + first * FRAME_BYTES);
+                }
+            });
+        for (std::thread &w : workers)
+            w.join();
+        bOK = munmap(map, bytes) == 0;
+    }
+    else
+    {
+        // CSV: format a round of blocks in parallel, then write them in order
+        FILE *f = fopen(path, "w");
+        if (f == NULL)
+        {
+            printf("  could not create %s\n", path);
+            return EXIT_FAILURE;
+        }
+        fprintf(f, "sample,out_a,out_b,dac_a,dac_b\n");
+
+        std::vector<std::string> texts(threads);
+        for (uint64_t round = 0; round < blocks && bOK; round += threads)
+        {
+            std::vector<std::thread> workers;
+            for (unsigned t = 0; t < threads && round + t < blocks; t++)
+                workers.emplace_back([&, t]()
+                {
+                    Block block;
+                    uint64_t b = round + t;
+                    uint64_t first = b * BLOCK_SAMPLES;
+                    block.render(channels, first, std::min(BLOCK_SAMPLES, samples - first));
+                    formatCsv(block, dac, first, texts[t]);
+                });
+            for (std::thread &w : workers)
+                w.join();
+            for (unsigned t = 0; t < threads && round + t < blocks; t++)
+                bOK = bOK && fwrite(texts[t].data(), 1, texts[t].size(), f) == texts[t].size();
+        }
+        bOK = (fclose(f) == 0) && bOK;
+    }
+
+    if (!bOK)
+    {
+        printf("  could not write %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Rendered %llu samples (%.3f s of signal) to %s in %.1f ms, %u threads\n",
+        (unsigned long long)samples, samples * 1.0 / SAMPLE_RATE, path, ms, threads);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,27 @@
+// WAVEGEN IP Example
+// Offline Waveform Renderer (wavegen_render.h)
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Host PC or Xilinx XUP Blackboard (no hardware access)
+
+//-----------------------------------------------------------------------------
+
+#ifndef WAVEGEN_RENDER_H
+#define WAVEGEN_RENDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// wavegen render FILE SECONDS COMMAND [-- COMMAND ...]
+// argv[0] is "render"; returns an EXIT_ code
+int wavegenRender(int argc, char *argv[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAVEGEN_RENDER_H
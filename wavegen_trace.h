@@ -0,0 +1,93 @@
+// WAVEGEN IP Example
+// Wavegen Driver Tracepoints (wavegen_trace.h)
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: Xilinx XUP Blackboard
+
+// Tracepoints for ftrace/perf, enable with
+//   echo 1 > /sys/kernel/tracing/events/wavegen/enable
+// or record with
+//   perf record -e 'wavegen:*'
+
+//-----------------------------------------------------------------------------
+
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM wavegen
+
+#if !defined(WAVEGEN_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define WAVEGEN_TRACE_H
+
+#include <linux/tracepoint.h>
+
+// Register access: word offset, value, time inside ioread32/iowrite32
+DECLARE_EVENT_CLASS(wavegen_reg,
+    TP_PROTO(unsigned int offset, u32 value, u64 ns),
+    TP_ARGS(offset, value, ns),
+    TP_STRUCT__entry(
+        __field(unsigned int, offset)
+        __field(u32, value)
+        __field(u64, ns)
+    ),
+    TP_fast_assign(
+        __entry->offset = offset;
+        __entry->value = value;
+        __entry->ns = ns;
+    ),
+    TP_printk("offset=%u value=0x%08x ns=%llu", __entry->offset, __entry->value, __entry->ns)
+);
+
+DEFINE_EVENT(wavegen_reg, wavegen_reg_read,
+    TP_PROTO(unsigned int offset, u32 value, u64 ns),
+    TP_ARGS(offset, value, ns)
+);
+
+DEFINE_EVENT(wavegen_reg, wavegen_reg_write,
+    TP_PROTO(unsigned int offset, u32 value, u64 ns),
+    TP_ARGS(offset, value, ns)
+);
+
+// Entry points (sysfs show/store, file operations): name and operation
+TRACE_EVENT(wavegen_entry,
+    TP_PROTO(const char *name, const char *op),
+    TP_ARGS(name, op),
+    TP_STRUCT__entry(
+        __array(char, name, 32)
+        __array(char, op, 8)
+    ),
+    TP_fast_assign(
+        strscpy(__entry->name, name, sizeof(__entry->name));
+        strscpy(__entry->op, op, sizeof(__entry->op));
+    ),
+    TP_printk("%s %s", __entry->op, __entry->name)
+);
+
+// Return from an entry point: result and total entry-to-return time
+TRACE_EVENT(wavegen_return,
+    TP_PROTO(const char *name, const char *op, long ret, u64 ns),
+    TP_ARGS(name, op, ret, ns),
+    TP_STRUCT__entry(
+        __array(char, name, 32)
+        __array(char, op, 8)
+        __field(long, ret)
+        __field(u64, ns)
+    ),
+    TP_fast_assign(
+        strscpy(__entry->name, name, sizeof(__entry->name));
+        strscpy(__entry->op, op, sizeof(__entry->op));
+        __entry->ret = ret;
+        __entry->ns = ns;
+    ),
+    TP_printk("%s %s ret=%ld ns=%llu", __entry->op, __entry->name, __entry->ret, __entry->ns)
+);
+
+#endif // WAVEGEN_TRACE_H
+
+// This part must be outside the include guard
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE wavegen_trace
+#include <trace/define_trace.h>
@@ -4,6 +4,10 @@
 	module wavegen_v1_0 #
 	(
 		// Users to add parameters here
+		parameter integer LUT_ADDR_WIDTH = 9,
+		parameter integer LUT_DATA_WIDTH = 16,
+		parameter LUT_FILE = "sin_LUT.mem",
+		parameter integer STREAM_FIFO_ADDR_WIDTH = 10,
 
 		// User parameters ends
 		// Do not modify the parameters beyond this line
@@ -11,7 +15,7 @@
 
 		// Parameters of Axi Slave Bus Interface S00_AXI
 		parameter integer C_S00_AXI_DATA_WIDTH	= 32,
-		parameter integer C_S00_AXI_ADDR_WIDTH	= 6,
+		parameter integer C_S00_AXI_ADDR_WIDTH	= 7,
 		parameter integer SAMPLING_FREQUENCY = 50000
 	)
 	(
@@ -20,6 +24,9 @@
         input EN,
         output signed [15:0] OUT_A,
         output signed [15:0] OUT_B,
+        input SYNC_IN,
+        output SYNC_OUT,
+        input TRIG_IN,
 		// User ports ends
 		// Do not modify the ports beyond this line
 
@@ -45,12 +52,21 @@
 		output wire [C_S00_AXI_DATA_WIDTH-1 : 0] s00_axi_rdata,
 		output wire [1 : 0] s00_axi_rresp,
 		output wire  s00_axi_rvalid,
-		input wire  s00_axi_rready
+		input wire  s00_axi_rready,
+
+		// Ports of Axi Stream Slave Bus Interface S00_AXIS (clocked by s00_axi_aclk)
+		input wire [31 : 0] s00_axis_tdata,
+		input wire  s00_axis_tvalid,
+		output wire  s00_axis_tready
 	);
 // Instantiation of Axi Bus Interface S00_AXI
 	wavegen_v1_0_S00_AXI # ( 
 		.C_S_AXI_ADDR_WIDTH(C_S00_AXI_ADDR_WIDTH),
-		.SAMPLING_FREQUENCY(SAMPLING_FREQUENCY)
+		.SAMPLING_FREQUENCY(SAMPLING_FREQUENCY),
+		.LUT_ADDR_WIDTH(LUT_ADDR_WIDTH),
+		.LUT_DATA_WIDTH(LUT_DATA_WIDTH),
+		.LUT_FILE(LUT_FILE),
+		.STREAM_FIFO_ADDR_WIDTH(STREAM_FIFO_ADDR_WIDTH)
 	) wavegen_v1_0_S00_AXI_inst (
 		.S_AXI_ACLK(s00_axi_aclk),
 		.S_AXI_ARESETN(s00_axi_aresetn),
@@ -77,7 +93,13 @@
 		.sample_clk(EN),
 		.LUT_CLK(CLK),
         .OUT_A(OUT_A),
-        .OUT_B(OUT_B)
+        .OUT_B(OUT_B),
+        .SYNC_IN(SYNC_IN),
+        .SYNC_OUT(SYNC_OUT),
+        .TRIG_IN(TRIG_IN),
+        .S_AXIS_TDATA(s00_axis_tdata),
+        .S_AXIS_TVALID(s00_axis_tvalid),
+        .S_AXIS_TREADY(s00_axis_tready)
 	);
 
 	// Add user logic here
@@ -3,8 +3,14 @@
 module wavegen_v1_0_S00_AXI #
 (
     // Bit width of S_AXI address bus
-    parameter integer C_S_AXI_ADDR_WIDTH = 6,
-    parameter integer SAMPLING_FREQUENCY = 50000
+    parameter integer C_S_AXI_ADDR_WIDTH = 7,
+    parameter integer SAMPLING_FREQUENCY = 50000,
+    // Sine lookup table, see SineWaves (sine.sv) and coe.py
+    parameter integer LUT_ADDR_WIDTH = 9,
+    parameter integer LUT_DATA_WIDTH = 16,
+    parameter LUT_FILE = "sin_LUT.mem",
+    // Stream FIFO depth is 2**STREAM_FIFO_ADDR_WIDTH samples
+    parameter integer STREAM_FIFO_ADDR_WIDTH = 10
 )
 (
     // Ports to top level module (what makes this the Wavegen IP module)
@@ -12,6 +18,14 @@ module wavegen_v1_0_S00_AXI #
     input LUT_CLK,
     output signed [15:0] OUT_A,
     output signed [15:0] OUT_B,
+    input SYNC_IN,
+    output SYNC_OUT,
+    input TRIG_IN,
+    
+    // Sample stream (AXI-Stream slave, clocked by S_AXI_ACLK), {B[31:16], A[15:0]}
+    input wire [31:0] S_AXIS_TDATA,
+    input wire S_AXIS_TVALID,
+    output wire S_AXIS_TREADY,
     
     // AXI clock and reset        
     input wire S_AXI_ACLK,
@@ -56,17 +70,85 @@ module wavegen_v1_0_S00_AXI #
     reg [15:0] offset_a, offset_b; //used
     reg [15:0] amp_a, amp_b; //used
     reg [15:0] dtcyc_a, dtcyc_b;
-    reg [15:0] cycles_a, cycles_b;
+    reg [31:0] cycles_a, cycles_b;
+    reg [15:0] stop_a, stop_b;
+    reg signed [15:0] idle_a, idle_b;
     reg [15:0] phase_off_a, phase_off_b;
+    reg [1:0] sync_mode;
+    reg sync_arm; // toggled on each arm request
+    reg [1:0] trig_arm, trig_source;
+    reg trig_falling;
+    reg trig_soft, trig_clear; // toggled on each software trigger / counter clear
+    reg [31:0] trig_holdoff;
+    reg [1:0] noise_shape_a, noise_shape_b;
+    reg [31:0] noise_seed_a, noise_seed_b;
+    reg stream_enable;
+    reg stream_flush, stream_clear; // one clock per flush / underrun counter clear
+    
+    // Preset slots hold the channel settings (the registers in preset_cfg
+    // order), a recall loads a whole slot at the next sample clock
+    localparam integer PRESET_SLOTS = 8;
+    localparam integer PRESET_WORDS = 15;
+    reg [31:0] presets [0:PRESET_SLOTS-1][0:PRESET_WORDS-1];
+    reg [2:0] preset_slot, recall_slot;
+    reg [3:0] preset_index; // word of preset_slot accessed through preset_data
+    reg recall_pending;
+    
+    // Multi-board synchronization gates RUN until the shared sync edge, the
+    // master sends the edge once armed and RUN is set
+    wire sync_armed, sync_gate;
+    PhaseSync sync(sample_clk, sync_mode, sync_arm, enable_a | enable_b, SYNC_IN, SYNC_OUT, sync_armed, sync_gate);
+    
+    // Armed channels are gated until a trigger, then run one burst
+    wire done_a, done_b;
+    wire [1:0] trig_gate;
+    wire [31:0] trig_count, trig_missed;
+    TriggerControl trigger(
+        sample_clk, trig_arm, trig_source, trig_falling, trig_soft, trig_clear,
+        TRIG_IN, SYNC_IN, trig_holdoff, {done_b, done_a},
+        trig_gate, trig_count, trig_missed
+    );
+    
+    wire run_a = enable_a & sync_gate & trig_gate[0];
+    wire run_b = enable_b & sync_gate & trig_gate[1];
     
     wire signed [15:0] wave_a_value; //used
     wire signed [15:0] wave_b_value; //used
     
-    wire signed [31:0] tempa = $signed(amp_a)*wave_a_value;
-    wire signed [31:0] tempb = $signed(amp_b)*wave_b_value;
+    // DMA sample stream, both channels pop from the same FIFO
+    localparam MODE_STREAM = 3'd7;
+    wire [31:0] stream_sample, stream_underruns;
+    wire [STREAM_FIFO_ADDR_WIDTH:0] stream_level;
+    StreamFifo #(
+        .ADDR_WIDTH(STREAM_FIFO_ADDR_WIDTH)
+    ) stream(
+        S_AXI_ACLK, S_AXI_ARESETN, stream_flush, stream_clear,
+        S_AXIS_TDATA, S_AXIS_TVALID, S_AXIS_TREADY,
+        sample_clk, stream_enable, stream_sample, stream_level, stream_underruns
+    );
     
-    assign OUT_A = enable_a ? ((tempa >> 15) + offset_a) : 16'd0;
-    assign OUT_B = enable_b ? ((tempb >> 15) + offset_b) : 16'd0;
+    wire signed [15:0] wave_a = (mode_a == MODE_STREAM) ? stream_sample[15:0] : wave_a_value;
+    wire signed [15:0] wave_b = (mode_b == MODE_STREAM) ? stream_sample[31:16] : wave_b_value;
+    
+    // Amplitude, offset and idle level are latched on the sample clock, the
+    // edge WaveForms applies a new mode and frequency on, so a recall (or a
+    // register write) never scales the previous sample with the new values
+    reg [15:0] amp_a_s = 0, amp_b_s = 0, offset_a_s = 0, offset_b_s = 0;
+    reg signed [15:0] idle_a_s = 0, idle_b_s = 0;
+    always @ (posedge sample_clk)
+    begin
+        amp_a_s <= amp_a;
+        amp_b_s <= amp_b;
+        offset_a_s <= offset_a;
+        offset_b_s <= offset_b;
+        idle_a_s <= idle_a;
+        idle_b_s <= idle_b;
+    end
+    
+    // Pipelined, saturating amplitude and offset scaling on the fast clock;
+    // enabled channels sit at the idle level while gated or after a burst
+    OutputStage output_a(LUT_CLK, wave_a, amp_a_s, offset_a_s, idle_a_s, enable_a, run_a & ~done_a, OUT_A);
+    OutputStage output_b(LUT_CLK, wave_b, amp_b_s, offset_b_s, idle_b_s, enable_b, run_b & ~done_b, OUT_B);
     
     vio_1 outputs (
       .clk(LUT_CLK),              // input wire clk
@@ -78,12 +160,16 @@ module wavegen_v1_0_S00_AXI #
    
     // Wave instantiations  
     WaveForms # (
-        .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY)
+        .SAMPLING_FREQUENCY(SAMPLING_FREQUENCY),
+        .LUT_ADDR_WIDTH(LUT_ADDR_WIDTH),
+        .LUT_DATA_WIDTH(LUT_DATA_WIDTH),
+        .LUT_FILE(LUT_FILE)
     ) A(
-        sample_clk, LUT_CLK, enable_a, enable_b,
+        sample_clk, LUT_CLK, run_a, run_b,
         mode_a, mode_b, freq_a, freq_b, dtcyc_a, dtcyc_b, 
-        phase_off_a, phase_off_b, cycles_a, cycles_b,
-        wave_a_value, wave_b_value
+        phase_off_a, phase_off_b, cycles_a, cycles_b, stop_a, stop_b,
+        noise_shape_a, noise_shape_b, noise_seed_a, noise_seed_b,
+        wave_a_value, wave_b_value, done_a, done_b
     );
     
     // Register map
@@ -95,19 +181,58 @@ module wavegen_v1_0_S00_AXI #
     //  16  offset (r/w) units of 100uV
     //  20  ampltd (r/w) units of 100uV
     //  24  dtcyc (r/w) units of 100%/2**16
-    //  28  cycles (r/w) units of 1 cycle
+    //  28  cycles (r/w) units of 1 cycle, lower 16 bits of cycles_a and cycles_b
     //  32  phase_off (r/w) units of 0.01 degrees (-180 to 180)
+    //  36  sync (r/w) mode [1:0] (0 off, 1 master, 2 slave), arm [2] (write 1 to arm, reads 1 while armed)
+    //  40  trig (r/w) arm [1:0] (B, A), source [3:2] (0 software, 1 pin, 2 sync in), falling [4], fire [5] (write 1)
+    //  44  holdoff (r/w) units of 1 sample
+    //  48  trig_count (r) triggers accepted, write clears trig_count and trig_missed
+    //  52  trig_missed (r) triggers ignored while busy or in holdoff
+    //  56  noise (r/w) shape A [1:0], shape B [17:16] (0 white, 1 pink, 2 band-limited)
+    //  60  noise_seed_a (r/w) 0 selects the default seed
+    //  64  noise_seed_b (r/w) 0 selects the default seed
+    //  68  cycles_a (r/w) units of 1 cycle, 0 with stop 0 runs forever
+    //  72  cycles_b (r/w) units of 1 cycle, 0 with stop 0 runs forever
+    //  76  stop (r/w) fraction of a cycle after the last whole cycle, units of 1/2**16 cycle
+    //  80  idle (r/w) output level while gated or after a burst, units of 100uV
+    //  84  stream_ctrl (r/w) enable [0] (pop one sample per sample clock), flush [1] (write 1)
+    //  88  stream_level (r) level [15:0] samples in the FIFO, depth [31:16]
+    //  92  stream_underrun (r) samples missed with the FIFO empty, write clears
+    //  96  preset (r/w) slot [2:0], save [4] (write 1, copies the channel settings to slot),
+    //      recall [5] (write 1, loads slot at the next sample, reads 1 until then),
+    //      index [11:8] (word of slot at preset_data), slots [19:16] (r),
+    //      last slot recalled [26:24] (r)
+    // 100  preset_data (r/w) word index of slot, writes advance index
+    //      words: mode, run, freqA, freqB, offset, ampltd, dtcyc, phase_off,
+    //      noise, noise_seed_a, noise_seed_b, cycles_a, cycles_b, stop, idle
     
     // Register numbers
-    localparam integer MODE_REG       = 4'b0000;
-    localparam integer RUN_REG        = 4'b0001;
-    localparam integer FREQ_A_REG     = 4'b0010;
-    localparam integer FREQ_B_REG     = 4'b0011;
-    localparam integer OFFSET_REG     = 4'b0100;
-    localparam integer AMPLTD_REG     = 4'b0101;
-    localparam integer DTCYC_REG      = 4'b0110;
-    localparam integer CYCLES_REG     = 4'b0111;
-    localparam integer PHASE_OFF_REG  = 4'b1000;
+    localparam integer MODE_REG       = 5'b00000;
+    localparam integer RUN_REG        = 5'b00001;
+    localparam integer FREQ_A_REG     = 5'b00010;
+    localparam integer FREQ_B_REG     = 5'b00011;
+    localparam integer OFFSET_REG     = 5'b00100;
+    localparam integer AMPLTD_REG     = 5'b00101;
+    localparam integer DTCYC_REG      = 5'b00110;
+    localparam integer CYCLES_REG     = 5'b00111;
+    localparam integer PHASE_OFF_REG  = 5'b01000;
+    localparam integer SYNC_REG       = 5'b01001;
+    localparam integer TRIG_REG       = 5'b01010;
+    localparam integer HOLDOFF_REG    = 5'b01011;
+    localparam integer TRIG_COUNT_REG = 5'b01100;
+    localparam integer TRIG_MISS_REG  = 5'b01101;
+    localparam integer NOISE_REG      = 5'b01110;
+    localparam integer SEED_A_REG     = 5'b01111;
+    localparam integer SEED_B_REG     = 5'b10000;
+    localparam integer CYCLES_A_REG   = 5'b10001;
+    localparam integer CYCLES_B_REG   = 5'b10010;
+    localparam integer STOP_REG       = 5'b10011;
+    localparam integer IDLE_REG       = 5'b10100;
+    localparam integer STREAM_REG     = 5'b10101;
+    localparam integer LEVEL_REG      = 5'b10110;
+    localparam integer UNDERRUN_REG   = 5'b10111;
+    localparam integer PRESET_REG     = 5'b11000;
+    localparam integer PRESET_DATA_REG = 5'b11001;
     
     // AXI4-lite signals
     reg axi_awready;
@@ -208,6 +333,31 @@ module wavegen_v1_0_S00_AXI #
     // int_clear_request write is only active for one clock
     wire wr = wr_add_data_valid && axi_awready && axi_wready;
     integer byte_index;
+    
+    // Channel settings as preset words, in register layout
+    wire [31:0] preset_cfg [0:PRESET_WORDS-1];
+    assign preset_cfg[0]  = {26'b0, mode_b, mode_a};
+    assign preset_cfg[1]  = {30'b0, enable_b, enable_a};
+    assign preset_cfg[2]  = freq_a;
+    assign preset_cfg[3]  = freq_b;
+    assign preset_cfg[4]  = {offset_b, offset_a};
+    assign preset_cfg[5]  = {amp_b, amp_a};
+    assign preset_cfg[6]  = {dtcyc_b, dtcyc_a};
+    assign preset_cfg[7]  = {phase_off_b, phase_off_a};
+    assign preset_cfg[8]  = {14'b0, noise_shape_b, 14'b0, noise_shape_a};
+    assign preset_cfg[9]  = noise_seed_a;
+    assign preset_cfg[10] = noise_seed_b;
+    assign preset_cfg[11] = cycles_a;
+    assign preset_cfg[12] = cycles_b;
+    assign preset_cfg[13] = {stop_b, stop_a};
+    assign preset_cfg[14] = {idle_b, idle_a};
+    
+    // A recall is applied just after a sample clock edge, so every setting
+    // changes together and has a whole sample period to reach the sample
+    // clock domain
+    reg [2:0] sample_sync;
+    wire sample_edge = sample_sync[1] & ~sample_sync[2];
+    integer slot_index, word_index;
     always_ff @ (posedge axi_clk)
     begin
         if (axi_resetn == 1'b0)
@@ -224,16 +374,46 @@ module wavegen_v1_0_S00_AXI #
             amp_b <= 16'b0;
             dtcyc_a <= 16'b0;
             dtcyc_b <= 16'b0;
-            cycles_a <= 16'b0;
-            cycles_b <= 16'b0;
+            cycles_a <= 32'b0;
+            cycles_b <= 32'b0;
+            stop_a <= 16'b0;
+            stop_b <= 16'b0;
+            idle_a <= 16'b0;
+            idle_b <= 16'b0;
             phase_off_a <= 16'b0;
             phase_off_b <= 16'b0;
+            sync_mode <= 2'b0;
+            sync_arm <= 1'b0;
+            trig_arm <= 2'b0;
+            trig_source <= 2'b0;
+            trig_falling <= 1'b0;
+            trig_soft <= 1'b0;
+            trig_clear <= 1'b0;
+            trig_holdoff <= 32'b0;
+            noise_shape_a <= 2'b0;
+            noise_shape_b <= 2'b0;
+            noise_seed_a <= 32'b0;
+            noise_seed_b <= 32'b0;
+            stream_enable <= 1'b0;
+            stream_flush <= 1'b0;
+            stream_clear <= 1'b0;
+            preset_slot <= 3'b0;
+            recall_slot <= 3'b0;
+            preset_index <= 4'b0;
+            recall_pending <= 1'b0;
+            sample_sync <= 3'b0;
+            for (slot_index = 0; slot_index < PRESET_SLOTS; slot_index = slot_index+1)
+                for (word_index = 0; word_index < PRESET_WORDS; word_index = word_index+1)
+                    presets[slot_index][word_index] <= 32'b0;
         end 
         else 
         begin
+            stream_flush <= 1'b0;
+            stream_clear <= 1'b0;
+            sample_sync <= {sample_sync[1:0], sample_clk};
             if (wr)
             begin
-                case (waddr[5:2])
+                case (waddr[6:2])
                     MODE_REG:
                         if (axi_wstrb[0] == 1)
                             {mode_b, mode_a} <= S_AXI_WDATA[5:0];
@@ -280,10 +460,14 @@ module wavegen_v1_0_S00_AXI #
                     end
                     CYCLES_REG:
                     begin
+                        if (axi_wstrb[1:0] != 0)
+                            cycles_a[31:16] <= 16'b0;
                         for (byte_index = 0; byte_index <= 1; byte_index = byte_index+1)
                             if (axi_wstrb[byte_index] == 1) 
                                 cycles_a[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
                                 
+                        if (axi_wstrb[3:2] != 0)
+                            cycles_b[31:16] <= 16'b0;
                         for (byte_index = 2; byte_index <= 3; byte_index = byte_index+1)
                             if (axi_wstrb[byte_index] == 1)
                                 cycles_b[((byte_index-2)*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
@@ -298,8 +482,127 @@ module wavegen_v1_0_S00_AXI #
                             if (axi_wstrb[byte_index] == 1)
                                 phase_off_b[((byte_index-2)*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
                     end
+                    SYNC_REG:
+                        if (axi_wstrb[0] == 1)
+                        begin
+                            sync_mode <= S_AXI_WDATA[1:0];
+                            if (S_AXI_WDATA[2])
+                                sync_arm <= ~sync_arm;
+                        end
+                    TRIG_REG:
+                        if (axi_wstrb[0] == 1)
+                        begin
+                            {trig_falling, trig_source, trig_arm} <= S_AXI_WDATA[4:0];
+                            if (S_AXI_WDATA[5])
+                                trig_soft <= ~trig_soft;
+                        end
+                    HOLDOFF_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                trig_holdoff[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    TRIG_COUNT_REG:
+                        trig_clear <= ~trig_clear;
+                    NOISE_REG:
+                    begin
+                        if (axi_wstrb[0] == 1)
+                            noise_shape_a <= S_AXI_WDATA[1:0];
+                        if (axi_wstrb[2] == 1)
+                            noise_shape_b <= S_AXI_WDATA[17:16];
+                    end
+                    SEED_A_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                noise_seed_a[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    SEED_B_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                noise_seed_b[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    CYCLES_A_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                cycles_a[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    CYCLES_B_REG:
+                        for (byte_index = 0; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                cycles_b[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    STOP_REG:
+                    begin
+                        for (byte_index = 0; byte_index <= 1; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1) 
+                                stop_a[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                                
+                        for (byte_index = 2; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                stop_b[((byte_index-2)*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    end
+                    IDLE_REG:
+                    begin
+                        for (byte_index = 0; byte_index <= 1; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1) 
+                                idle_a[(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                                
+                        for (byte_index = 2; byte_index <= 3; byte_index = byte_index+1)
+                            if (axi_wstrb[byte_index] == 1)
+                                idle_b[((byte_index-2)*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                    end
+                    STREAM_REG:
+                        if (axi_wstrb[0] == 1)
+                        begin
+                            stream_enable <= S_AXI_WDATA[0];
+                            stream_flush <= S_AXI_WDATA[1];
+                        end
+                    UNDERRUN_REG:
+                        stream_clear <= 1'b1;
+                    PRESET_REG:
+                    begin
+                        if (axi_wstrb[0] == 1)
+                        begin
+                            preset_slot <= S_AXI_WDATA[2:0];
+                            if (S_AXI_WDATA[4])
+                                for (word_index = 0; word_index < PRESET_WORDS; word_index = word_index+1)
+                                    presets[S_AXI_WDATA[2:0]][word_index] <= preset_cfg[word_index];
+                            if (S_AXI_WDATA[5])
+                            begin
+                                recall_slot <= S_AXI_WDATA[2:0];
+                                recall_pending <= 1'b1;
+                            end
+                        end
+                        if (axi_wstrb[1] == 1)
+                            preset_index <= S_AXI_WDATA[11:8];
+                    end
+                    PRESET_DATA_REG:
+                    begin
+                        if (preset_index < PRESET_WORDS)
+                            for (byte_index = 0; byte_index <= 3; byte_index = byte_index+1)
+                                if (axi_wstrb[byte_index] == 1)
+                                    presets[preset_slot][preset_index][(byte_index*8) +: 8] <= S_AXI_WDATA[(byte_index*8) +: 8];
+                        preset_index <= preset_index + 1;
+                    end
                 endcase
             end
+            
+            // Load the recalled slot, after any register write in the same
+            // clock
+            if (recall_pending && sample_edge)
+            begin
+                {mode_b, mode_a} <= presets[recall_slot][0][5:0];
+                {enable_b, enable_a} <= presets[recall_slot][1][1:0];
+                freq_a <= presets[recall_slot][2];
+                freq_b <= presets[recall_slot][3];
+                {offset_b, offset_a} <= presets[recall_slot][4];
+                {amp_b, amp_a} <= presets[recall_slot][5];
+                {dtcyc_b, dtcyc_a} <= presets[recall_slot][6];
+                {phase_off_b, phase_off_a} <= presets[recall_slot][7];
+                noise_shape_a <= presets[recall_slot][8][1:0];
+                noise_shape_b <= presets[recall_slot][8][17:16];
+                noise_seed_a <= presets[recall_slot][9];
+                noise_seed_b <= presets[recall_slot][10];
+                cycles_a <= presets[recall_slot][11];
+                cycles_b <= presets[recall_slot][12];
+                {stop_b, stop_a} <= presets[recall_slot][13];
+                {idle_b, idle_a} <= presets[recall_slot][14];
+                recall_pending <= 1'b0;
+            end
         end
     end    
 
@@ -370,7 +673,7 @@ module wavegen_v1_0_S00_AXI #
             if (rd)
             begin
 		// Address decoding for reading registers
-		case (raddr[5:2])
+		case (raddr[6:2])
 		    MODE_REG: 
 		        axi_rdata <= {26'b0, mode_b, mode_a};
 		    RUN_REG:
@@ -386,9 +689,43 @@ module wavegen_v1_0_S00_AXI #
 		    DTCYC_REG:
 			    axi_rdata <= {dtcyc_b, dtcyc_a};
 		    CYCLES_REG:
-		        axi_rdata <= {cycles_b, cycles_a};
+		        axi_rdata <= {cycles_b[15:0], cycles_a[15:0]};
 		    PHASE_OFF_REG:
 		        axi_rdata <= {phase_off_b, phase_off_a};
+		    SYNC_REG:
+		        axi_rdata <= {29'b0, sync_armed, sync_mode};
+		    TRIG_REG:
+		        axi_rdata <= {27'b0, trig_falling, trig_source, trig_arm};
+		    HOLDOFF_REG:
+		        axi_rdata <= trig_holdoff;
+		    TRIG_COUNT_REG:
+		        axi_rdata <= trig_count;
+		    TRIG_MISS_REG:
+		        axi_rdata <= trig_missed;
+		    NOISE_REG:
+		        axi_rdata <= {14'b0, noise_shape_b, 14'b0, noise_shape_a};
+		    SEED_A_REG:
+		        axi_rdata <= noise_seed_a;
+		    SEED_B_REG:
+		        axi_rdata <= noise_seed_b;
+		    CYCLES_A_REG:
+		        axi_rdata <= cycles_a;
+		    CYCLES_B_REG:
+		        axi_rdata <= cycles_b;
+		    STOP_REG:
+		        axi_rdata <= {stop_b, stop_a};
+		    IDLE_REG:
+		        axi_rdata <= {idle_b, idle_a};
+		    STREAM_REG:
+		        axi_rdata <= {31'b0, stream_enable};
+		    LEVEL_REG:
+		        axi_rdata <= {16'(2**STREAM_FIFO_ADDR_WIDTH), 16'(stream_level)};
+		    UNDERRUN_REG:
+		        axi_rdata <= stream_underruns;
+		    PRESET_REG:
+		        axi_rdata <= {5'b0, recall_slot, 4'b0, 4'(PRESET_SLOTS), 4'b0, preset_index, 2'b0, recall_pending, 2'b0, preset_slot};
+		    PRESET_DATA_REG:
+		        axi_rdata <= (preset_index < PRESET_WORDS) ? presets[preset_slot][preset_index] : 32'b0;
 		endcase
             end   
         end